@@ -0,0 +1,166 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/collapse_mapped.hpp>
+#include <mockturtle/algorithms/lut_mapping.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/utils/node_map.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+#include <mockturtle/views/mapping_view.hpp>
+
+#include <experiments.hpp>
+
+/* memory allocated for the nodes, their fan-ins, and the structural hash table
+ * (without allocator overhead, which only adds to the vector-based storage) */
+template<class Ntk>
+double storage_megabytes( Ntk const& ntk )
+{
+  auto const& st = *ntk._storage;
+  using node_type = typename std::decay_t<decltype( st.nodes )>::value_type;
+  using hash_entry_type = typename std::decay_t<decltype( st.hash )>::value_type;
+  using pointer_type = typename node_type::pointer_type;
+
+  /* flat hash maps store one control byte per slot */
+  uint64_t bytes = st.nodes.capacity() * sizeof( node_type ) +
+                   st.hash.capacity() * ( sizeof( hash_entry_type ) + 1u );
+  if constexpr ( std::is_same_v<Ntk, mockturtle::arena_klut_network> )
+  {
+    bytes += st.data.fanins.num_bytes();
+  }
+  else
+  {
+    /* every node and every hash table key owns its fan-in vector */
+    for ( auto const& n : st.nodes )
+    {
+      bytes += n.children.capacity() * sizeof( pointer_type );
+    }
+    for ( auto const& [key, _] : st.hash )
+    {
+      bytes += key.children.capacity() * sizeof( pointer_type );
+    }
+  }
+  return static_cast<double>( bytes ) / ( 1024.0 * 1024.0 );
+}
+
+/* rebuilds a k-LUT network gate by gate in a different storage */
+template<class Ntk>
+Ntk copy_klut( mockturtle::klut_network const& src )
+{
+  using namespace mockturtle;
+
+  Ntk dest;
+  node_map<signal<Ntk>, klut_network> old2new( src );
+  old2new[src.get_constant( false )] = dest.get_constant( false );
+  old2new[src.get_constant( true )] = dest.get_constant( true );
+  src.foreach_pi( [&]( auto const& n ) {
+    old2new[n] = dest.create_pi();
+  } );
+
+  std::vector<signal<Ntk>> children;
+  src.foreach_gate( [&]( auto const& n ) {
+    children.clear();
+    src.foreach_fanin( n, [&]( auto const& f ) {
+      children.push_back( old2new[f] );
+    } );
+    old2new[n] = dest.create_node( children, src.node_function( n ) );
+  } );
+
+  src.foreach_po( [&]( auto const& f ) {
+    dest.create_po( old2new[f] );
+  } );
+  return dest;
+}
+
+/* visits all fan-ins of all gates a couple of times */
+template<class Ntk>
+uint64_t traverse_fanins( Ntk const& ntk, std::vector<mockturtle::node<Ntk>> const& gates )
+{
+  uint64_t checksum{0};
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    for ( auto const& n : gates )
+    {
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        checksum += ntk.node_to_index( ntk.get_node( f ) );
+      } );
+    }
+  }
+  return checksum;
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double, double, double, double, bool> exp( "arena_klut", "benchmark", "luts", "MB", "MB arena", "build", "build arena", "fanins", "fanins arena", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    mapping_view<aig_network, true> mapped_aig{aig};
+    lut_mapping<decltype( mapped_aig ), true>( mapped_aig );
+    const auto klut = *collapse_mapped_network<klut_network>( mapped_aig );
+
+    stopwatch<>::duration time_build{0}, time_build_arena{0};
+    const auto vector_klut = call_with_stopwatch( time_build, [&]() { return copy_klut<klut_network>( klut ); } );
+    const auto arena_klut = call_with_stopwatch( time_build_arena, [&]() { return copy_klut<arena_klut_network>( klut ); } );
+
+    std::vector<klut_network::node> gates;
+    klut.foreach_gate( [&]( auto const& n ) {
+      gates.push_back( n );
+    } );
+
+    stopwatch<>::duration time_fanins{0}, time_fanins_arena{0};
+    const auto checksum = call_with_stopwatch( time_fanins, [&]() { return traverse_fanins( vector_klut, gates ); } );
+    const auto checksum_arena = call_with_stopwatch( time_fanins_arena, [&]() { return traverse_fanins( arena_klut, gates ); } );
+
+    /* both copies must be structurally identical */
+    bool const equal = vector_klut.size() == arena_klut.size() && checksum == checksum_arena;
+
+    exp( benchmark, klut.num_gates(), storage_megabytes( vector_klut ), storage_megabytes( arena_klut ),
+         to_seconds( time_build ), to_seconds( time_build_arena ),
+         to_seconds( time_fanins ), to_seconds( time_fanins_arena ), equal );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,100 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+/* memory allocated for the nodes and the structural hash table */
+template<class Ntk>
+double storage_megabytes( Ntk const& ntk )
+{
+  auto const& st = *ntk._storage;
+  using node_type = typename std::decay_t<decltype( st.nodes )>::value_type;
+  using hash_entry_type = typename std::decay_t<decltype( st.hash )>::value_type;
+
+  /* flat hash maps store one control byte per slot */
+  auto const bytes = st.nodes.capacity() * sizeof( node_type ) +
+                     st.hash.capacity() * ( sizeof( hash_entry_type ) + 1u );
+  return static_cast<double>( bytes ) / ( 1024.0 * 1024.0 );
+}
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  experiment<std::string, uint32_t, double, double, double, double, double, bool> exp( "compact_storage", "benchmark", "size", "MB", "MB compact", "ratio", "read time", "read time compact", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+
+    stopwatch<>::duration time_aig{0};
+    aig_network aig;
+    auto const res_aig = call_with_stopwatch( time_aig, [&]() {
+      return lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) );
+    } );
+    if ( res_aig != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    stopwatch<>::duration time_compact{0};
+    compact_aig_network compact_aig;
+    auto const res_compact = call_with_stopwatch( time_compact, [&]() {
+      return lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( compact_aig ) );
+    } );
+    if ( res_compact != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    /* both networks must be structurally identical */
+    bool equal = aig.size() == compact_aig.size() && aig.num_gates() == compact_aig.num_gates();
+    aig.foreach_gate( [&]( auto const& n ) {
+      compact_aig.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        equal &= ( f.data == aig._storage->nodes[n].children[i].data );
+      } );
+    } );
+
+    auto const mb = storage_megabytes( aig );
+    auto const mb_compact = storage_megabytes( compact_aig );
+    exp( benchmark, aig.num_gates(), mb, mb_compact, mb_compact / mb, to_seconds( time_aig ), to_seconds( time_compact ), equal );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
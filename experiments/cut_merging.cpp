@@ -0,0 +1,134 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/simd_kernels.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+using namespace mockturtle;
+
+/* merges all pairs of fanin cuts of every gate and filters dominated cuts, as
+ * in cut enumeration; returns a checksum over the surviving cuts */
+uint64_t merge_fanin_cuts( aig_network const& aig, network_cuts<aig_network, false, empty_cut_data> const& cuts, simd::cut_kernels const& k, uint32_t cut_size )
+{
+  uint64_t checksum{0u};
+  std::vector<std::array<uint32_t, 16u>> result;
+  std::vector<uint32_t> lengths;
+
+  aig.foreach_gate( [&]( auto const& n ) {
+    std::array<uint32_t, 2u> fanin{};
+    aig.foreach_fanin( n, [&]( auto const& f, auto i ) { fanin[i] = aig.node_to_index( aig.get_node( f ) ); } );
+
+    result.clear();
+    lengths.clear();
+    for ( auto const& c1 : cuts.cuts( fanin[0] ) )
+    {
+      for ( auto const& c2 : cuts.cuts( fanin[1] ) )
+      {
+        std::array<uint32_t, 16u> leaves;
+        const auto length = k.leaves_union( &*c1->begin(), c1->size(), &*c2->begin(), c2->size(), leaves.data(), cut_size );
+        if ( length > cut_size )
+        {
+          continue;
+        }
+
+        bool dominated{false};
+        for ( auto i = 0u; i < result.size() && !dominated; ++i )
+        {
+          dominated = lengths[i] <= length && k.leaves_subset( result[i].data(), lengths[i], leaves.data(), length );
+        }
+        if ( !dominated )
+        {
+          result.push_back( leaves );
+          lengths.push_back( length );
+          checksum = checksum * 31u + length + leaves[length - 1u];
+        }
+      }
+    }
+  } );
+
+  return checksum;
+}
+
+int main()
+{
+  using namespace experiments;
+
+  constexpr uint32_t num_rounds = 3u;
+
+  cut_enumeration_params ps;
+  ps.cut_size = 6u;
+  ps.cut_limit = 25u;
+
+  const auto best = simd::detect_instruction_set();
+  fmt::print( "[i] using {} cut kernels\n", best == simd::instruction_set::avx512 ? "AVX-512" : ( best == simd::instruction_set::avx2 ? "AVX2" : "scalar" ) );
+
+  experiment<std::string, uint32_t, uint32_t, double, double, double, double, bool> exp( "cut_merging", "benchmark", "gates", "cuts", "enumeration", "merge scalar", "merge avx2", "merge best", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    cut_enumeration_stats st;
+    const auto cuts = cut_enumeration( aig, ps, &st );
+
+    const auto expected = merge_fanin_cuts( aig, cuts, simd::get_cut_kernels( simd::instruction_set::scalar ), ps.cut_size );
+    bool equivalent = true;
+    std::vector<double> times;
+    for ( auto isa : {simd::instruction_set::scalar, simd::instruction_set::avx2, best} )
+    {
+      auto const& k = simd::get_cut_kernels( static_cast<int>( isa ) <= static_cast<int>( best ) ? isa : simd::instruction_set::scalar );
+      stopwatch<>::duration time{0};
+      for ( auto i = 0u; i < num_rounds; ++i )
+      {
+        equivalent &= call_with_stopwatch( time, [&]() { return merge_fanin_cuts( aig, cuts, k, ps.cut_size ); } ) == expected;
+      }
+      times.push_back( to_seconds( time ) );
+    }
+
+    exp( benchmark, aig.num_gates(), cuts.total_cuts(), to_seconds( st.time_total ), times[0], times[1], times[2], equivalent );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
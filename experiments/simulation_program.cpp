@@ -0,0 +1,93 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <kitty/partial_truth_table.hpp>
+#include <lorina/aiger.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/simulation_program.hpp>
+#include <mockturtle/io/aiger_reader.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/stopwatch.hpp>
+
+#include <experiments.hpp>
+
+int main()
+{
+  using namespace experiments;
+  using namespace mockturtle;
+
+  /* number of pattern blocks simulated per benchmark and their size in words */
+  constexpr uint32_t num_rounds = 20u;
+  constexpr uint32_t num_words = 16u;
+
+  experiment<std::string, uint32_t, uint32_t, double, double, double, double, double, bool> exp( "simulation_program", "benchmark", "gates", "slots", "compile", "nodes 1w", "program 1w", "nodes 16w", "program 16w", "equivalent" );
+
+  for ( auto const& benchmark : epfl_benchmarks() )
+  {
+    fmt::print( "[i] processing {}\n", benchmark );
+    aig_network aig;
+    if ( lorina::read_aiger( benchmark_path( benchmark ), aiger_reader( aig ) ) != lorina::return_code::success )
+    {
+      continue;
+    }
+
+    stopwatch<>::duration time_compile{0};
+    auto program = call_with_stopwatch( time_compile, [&]() { return compile_simulation( aig ); } );
+
+    bool equivalent = true;
+    std::vector<double> times;
+    for ( auto words : {1u, num_words} )
+    {
+      std::vector<partial_simulator> sims;
+      for ( auto i = 0u; i < num_rounds; ++i )
+      {
+        sims.emplace_back( aig.num_pis(), words * 64u, i + 1u );
+      }
+
+      stopwatch<>::duration time_nodes{0}, time_program{0};
+      for ( auto const& sim : sims )
+      {
+        const auto values = call_with_stopwatch( time_nodes, [&]() { return simulate_nodes<kitty::partial_truth_table>( aig, sim ); } );
+        const auto pos = call_with_stopwatch( time_program, [&]() { return program.simulate<kitty::partial_truth_table>( sim ); } );
+        aig.foreach_po( [&]( auto const& f, auto i ) {
+          equivalent &= pos[i] == ( aig.is_complemented( f ) ? ~values[f] : values[f] );
+        } );
+      }
+      times.push_back( to_seconds( time_nodes ) );
+      times.push_back( to_seconds( time_program ) );
+    }
+
+    exp( benchmark, aig.num_gates(), program.num_slots(), to_seconds( time_compile ), times[0], times[1], times[2], times[3], equivalent );
+  }
+
+  exp.save();
+  exp.table();
+
+  return 0;
+}
@@ -0,0 +1,530 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file compact_cut_enumeration.hpp
+  \brief Cut enumeration into a compact cut database
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <kitty/constructors.hpp>
+#include <kitty/dynamic_truth_table.hpp>
+
+#include "../traits.hpp"
+#include "../utils/stopwatch.hpp"
+#include "../utils/truth_table_cache.hpp"
+#include "cut_enumeration.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for compact_cut_enumeration.
+ *
+ * In addition to the parameters of `cut_enumeration`, the cut sets of nodes
+ * can be freed as soon as they are no longer needed.
+ */
+struct compact_cut_enumeration_params : cut_enumeration_params
+{
+  /*! \brief Free the cut set of a node once all its fanouts are processed. */
+  bool streaming{false};
+};
+
+/*! \cond PRIVATE */
+template<typename Ntk, bool ComputeTruth, typename CutData>
+class compact_network_cuts;
+
+template<typename Ntk, bool ComputeTruth = false, typename CutData = empty_cut_data>
+compact_network_cuts<Ntk, ComputeTruth, CutData> compact_cut_enumeration( Ntk const& ntk, compact_cut_enumeration_params const& ps = {}, cut_enumeration_stats* pst = nullptr,
+                                                                          std::function<void( node<Ntk> const&, typename compact_network_cuts<Ntk, ComputeTruth, CutData>::cut_set_t const& )> const& on_cuts = {} );
+/*! \endcond */
+
+/*! \brief Compact cut database for a network.
+ *
+ * Holds the same cuts as `network_cuts`, but packs the cuts of each node,
+ * with as many leaves and cuts as it has, into one global arena of words.
+ * A node refers to its cuts by an offset into the arena.  Freed cut sets
+ * leave holes in the arena, which are closed when the arena would have to
+ * grow otherwise.
+ *
+ * The cut set of a node is unpacked on access.  The reference returned by
+ * `cuts` is valid until the next call to `cuts`.
+ *
+ * An instance of type `compact_network_cuts` can only be constructed from
+ * the `compact_cut_enumeration` algorithm.
+ */
+template<typename Ntk, bool ComputeTruth, typename CutData>
+class compact_network_cuts
+{
+public:
+  static constexpr uint32_t max_cut_num = 26;
+  using cut_t = cut_type<ComputeTruth, CutData>;
+  using cut_set_t = cut_set<cut_t, max_cut_num>;
+  static constexpr bool compute_truth = ComputeTruth;
+
+private:
+  static constexpr uint64_t no_offset = std::numeric_limits<uint64_t>::max();
+
+  /* per cut: length, function (if computed), data, and leaves */
+  static constexpr uint32_t func_words = ComputeTruth ? 1u : 0u;
+  static constexpr uint32_t data_words = std::is_empty_v<CutData> ? 0u : static_cast<uint32_t>( ( sizeof( CutData ) + sizeof( uint32_t ) - 1u ) / sizeof( uint32_t ) );
+
+  /* per cut set: size in words, node index, and number of cuts */
+  static constexpr uint32_t header_words = 3u;
+
+  static_assert( std::is_trivially_copyable_v<CutData>, "CutData must be trivially copyable to be packed" );
+
+  explicit compact_network_cuts( uint32_t size ) : _offsets( size, no_offset )
+  {
+    kitty::dynamic_truth_table zero( 0u ), proj( 1u );
+    kitty::create_nth_var( proj, 0u );
+
+    _truth_tables.insert( zero );
+    _truth_tables.insert( proj );
+  }
+
+public:
+  /*! \brief Returns the cut set of a node (empty if it was freed)
+   *
+   * The returned reference is valid until the next call to `cuts`.
+   */
+  cut_set_t const& cuts( uint32_t node_index ) const
+  {
+    if ( node_index != _view_index )
+    {
+      unpack( node_index, _view );
+      _view_index = node_index;
+    }
+    return _view;
+  }
+
+  /*! \brief Unpacks the cut set of a node into `set` */
+  void unpack( uint32_t node_index, cut_set_t& set ) const
+  {
+    set.clear();
+
+    const auto offset = _offsets[node_index];
+    if ( offset == no_offset )
+    {
+      return;
+    }
+
+    auto const* word = _arena.data() + offset + 2u;
+    const auto num_cuts = *word++;
+    for ( auto i = 0u; i < num_cuts; ++i )
+    {
+      const auto length = *word++;
+      auto const* leaves = word + func_words + data_words;
+      auto& cut = set.add_cut( leaves, leaves + length );
+
+      if constexpr ( ComputeTruth )
+      {
+        cut->func_id = word[0];
+      }
+      if constexpr ( data_words > 0u )
+      {
+        std::memcpy( static_cast<void*>( &cut->data ), word + func_words, sizeof( CutData ) );
+      }
+      word = leaves + length;
+    }
+  }
+
+  /*! \brief Returns whether the cut set of a node is stored */
+  bool has_cuts( uint32_t node_index ) const
+  {
+    return _offsets[node_index] != no_offset;
+  }
+
+  /*! \brief Returns the number of cuts of a node (without unpacking them) */
+  uint32_t num_cuts( uint32_t node_index ) const
+  {
+    const auto offset = _offsets[node_index];
+    return offset == no_offset ? 0u : _arena[offset + 2u];
+  }
+
+  /*! \brief Returns the truth table of a cut */
+  template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
+  auto truth_table( cut_t const& cut ) const
+  {
+    return _truth_tables[cut->func_id];
+  }
+
+  /*! \brief Returns the total number of tuples that were tried to be merged */
+  auto total_tuples() const
+  {
+    return _total_tuples;
+  }
+
+  /*! \brief Returns the total number of cuts that were computed */
+  auto total_cuts() const
+  {
+    return _total_cuts;
+  }
+
+  /*! \brief Returns the number of nodes for which cuts are computed */
+  auto nodes_size() const
+  {
+    return _offsets.size();
+  }
+
+  /*! \brief Returns the number of bytes allocated for the cut sets */
+  uint64_t num_bytes() const
+  {
+    return _arena.capacity() * sizeof( uint32_t ) + _offsets.capacity() * sizeof( uint64_t );
+  }
+
+  /*! \brief Returns the largest number of bytes allocated for the cut sets */
+  uint64_t peak_num_bytes() const
+  {
+    return std::max( _peak_num_bytes, num_bytes() );
+  }
+
+  /* compute positions of leave indices in cut `sub` (subset) with respect to
+   * leaves in cut `sup` (super set).
+   *
+   * Example:
+   *   compute_truth_table_support( {1, 3, 6}, {0, 1, 2, 3, 6, 7} ) = {1, 3, 4}
+   */
+  std::vector<uint8_t> compute_truth_table_support( cut_t const& sub, cut_t const& sup ) const
+  {
+    std::vector<uint8_t> support;
+    support.reserve( sub.size() );
+
+    auto itp = sup.begin();
+    for ( auto i : sub )
+    {
+      itp = std::find( itp, sup.end(), i );
+      support.push_back( static_cast<uint8_t>( std::distance( sup.begin(), itp ) ) );
+    }
+
+    return support;
+  }
+
+  /*! \brief Inserts a truth table into the truth table cache.
+   *
+   * \param tt Truth table to add
+   * \return Literal id from the truth table store
+   */
+  uint32_t insert_truth_table( kitty::dynamic_truth_table const& tt )
+  {
+    return _truth_tables.insert( tt );
+  }
+
+private:
+  template<typename _Ntk, bool _ComputeTruth, typename _CutData, typename _NetworkCuts>
+  friend class detail::cut_enumeration_impl;
+
+  template<typename _Ntk, bool _ComputeTruth, typename _CutData>
+  friend compact_network_cuts<_Ntk, _ComputeTruth, _CutData> compact_cut_enumeration( _Ntk const& ntk, compact_cut_enumeration_params const& ps, cut_enumeration_stats* pst,
+                                                                                      std::function<void( node<_Ntk> const&, typename compact_network_cuts<_Ntk, _ComputeTruth, _CutData>::cut_set_t const& )> const& on_cuts );
+
+private:
+  /* cut set of a node during enumeration, unpacked into a staging slot;
+   * slots stay valid until `clear_staged` */
+  cut_set_t& enumeration_cuts( uint32_t index )
+  {
+    for ( auto i = 0u; i < _num_staged; ++i )
+    {
+      if ( _staged_index[i] == index )
+      {
+        return _staged[i];
+      }
+    }
+
+    if ( _num_staged == _staged.size() )
+    {
+      _staged.emplace_back();
+      _staged_index.emplace_back();
+    }
+    _staged_index[_num_staged] = index;
+    unpack( index, _staged[_num_staged] );
+    return _staged[_num_staged++];
+  }
+
+  void clear_staged()
+  {
+    _num_staged = 0u;
+  }
+
+  void add_zero_cut( uint32_t index )
+  {
+    auto& cut = enumeration_cuts( index ).add_cut( &index, &index ); /* fake iterator for emptyness */
+    cut.data() = {}; /* staging slots are reused */
+
+    if constexpr ( ComputeTruth )
+    {
+      cut->func_id = 0;
+    }
+  }
+
+  void add_unit_cut( uint32_t index )
+  {
+    auto& cut = enumeration_cuts( index ).add_cut( &index, &index + 1 );
+    cut.data() = {}; /* staging slots are reused */
+
+    if constexpr ( ComputeTruth )
+    {
+      cut->func_id = 2;
+    }
+  }
+
+  /* packs the cut set of a node into the arena */
+  void store( uint32_t index, cut_set_t const& set )
+  {
+    release( index );
+
+    auto words = header_words;
+    for ( auto const& cut : set )
+    {
+      words += 1u + func_words + data_words + cut->size();
+    }
+
+    /* close the holes before the arena grows */
+    if ( _arena.size() + words > _arena.capacity() && 2u * _garbage >= _arena.size() )
+    {
+      compact();
+    }
+    if ( _arena.size() + words > _arena.capacity() )
+    {
+      _peak_num_bytes = std::max( _peak_num_bytes, num_bytes() );
+    }
+
+    _offsets[index] = _arena.size();
+    _arena.push_back( words );
+    _arena.push_back( index );
+    _arena.push_back( static_cast<uint32_t>( set.size() ) );
+    for ( auto const& cut : set )
+    {
+      _arena.push_back( cut->size() );
+      if constexpr ( ComputeTruth )
+      {
+        _arena.push_back( ( *cut )->func_id );
+      }
+      if constexpr ( data_words > 0u )
+      {
+        const auto pos = _arena.size();
+        _arena.resize( pos + data_words, 0u );
+        std::memcpy( _arena.data() + pos, static_cast<void const*>( &( *cut )->data ), sizeof( CutData ) );
+      }
+      _arena.insert( _arena.end(), cut->begin(), cut->end() );
+    }
+  }
+
+  /* frees the cut set of a node */
+  void release( uint32_t index )
+  {
+    if ( const auto offset = _offsets[index]; offset != no_offset )
+    {
+      _garbage += _arena[offset];
+      _offsets[index] = no_offset;
+    }
+    if ( index == _view_index )
+    {
+      _view_index = no_index;
+    }
+  }
+
+  /* moves all stored cut sets to the front of the arena */
+  void compact()
+  {
+    uint64_t to = 0u;
+    for ( uint64_t from = 0u; from < _arena.size(); )
+    {
+      const auto words = _arena[from];
+      const auto index = _arena[from + 1u];
+      if ( _offsets[index] == from )
+      {
+        std::copy( _arena.begin() + from, _arena.begin() + from + words, _arena.begin() + to );
+        _offsets[index] = to;
+        to += words;
+      }
+      from += words;
+    }
+    _arena.resize( to );
+    _garbage = 0u;
+  }
+
+private:
+  static constexpr uint32_t no_index = std::numeric_limits<uint32_t>::max();
+
+  /* cut sets of all nodes, one after another */
+  std::vector<uint32_t> _arena;
+
+  /* position of each node's cut set in the arena */
+  std::vector<uint64_t> _offsets;
+
+  /* words in the arena that belong to freed cut sets */
+  uint64_t _garbage{0u};
+  uint64_t _peak_num_bytes{0u};
+
+  /* unpacked cut sets of the node under enumeration and its fanins */
+  std::deque<cut_set_t> _staged;
+  std::vector<uint32_t> _staged_index;
+  uint32_t _num_staged{0u};
+
+  /* last unpacked cut set returned by `cuts` */
+  mutable cut_set_t _view;
+  mutable uint32_t _view_index{no_index};
+
+  /* cut truth tables */
+  truth_table_cache<kitty::dynamic_truth_table> _truth_tables;
+
+  /* statistics */
+  uint32_t _total_tuples{};
+  std::size_t _total_cuts{};
+};
+
+/*! \brief Cut enumeration into a compact cut database.
+ *
+ * Computes the same cuts as `cut_enumeration`, but stores them in a
+ * `compact_network_cuts` database, in which each node takes only as much
+ * memory as its cuts need, instead of `max_cut_num` cuts of `max_cut_size`
+ * leaves.
+ *
+ * The optional callback `on_cuts` is called with each node and its cut set
+ * right after the cut set has been computed, in topological order.  With
+ * `streaming` enabled, the cut set of a node is freed once the cut sets of
+ * all its fanout gates have been computed (or right after the callback, if
+ * the node has no fanout gates).  Then, only the cut sets of the current
+ * frontier of the network are kept in memory, and the callback is the place
+ * to consume the cuts.
+ *
+ * The enumeration runs in a single thread, `num_threads` is ignored.
+ *
+ * **Required network functions:**
+ * - `is_constant`
+ * - `is_pi`
+ * - `size`
+ * - `get_node`
+ * - `node_to_index`
+ * - `foreach_node`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `compute` for `kitty::dynamic_truth_table` (if `ComputeTruth` is true)
+ *
+   \verbatim embed:rst
+
+   .. warning::
+
+      This algorithm expects the nodes in the network to be in topological
+      order.  In streaming mode, a `CutData` whose update function reads the
+      cut sets of the leaves (such as ``cut_enumeration_mf_cut``) may find
+      them already freed.
+   \endverbatim
+ */
+template<typename Ntk, bool ComputeTruth, typename CutData>
+compact_network_cuts<Ntk, ComputeTruth, CutData> compact_cut_enumeration( Ntk const& ntk, compact_cut_enumeration_params const& ps, cut_enumeration_stats* pst,
+                                                                          std::function<void( node<Ntk> const&, typename compact_network_cuts<Ntk, ComputeTruth, CutData>::cut_set_t const& )> const& on_cuts )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( !ComputeTruth || has_compute_v<Ntk, kitty::dynamic_truth_table>, "Ntk does not implement the compute method for kitty::dynamic_truth_table" );
+
+  using network_cuts_t = compact_network_cuts<Ntk, ComputeTruth, CutData>;
+
+  cut_enumeration_stats st;
+  network_cuts_t res( ntk.size() );
+  detail::cut_enumeration_impl<Ntk, ComputeTruth, CutData, network_cuts_t> p( ntk, ps, st, res );
+
+  /* number of fanout gates whose cut sets are not computed yet */
+  std::vector<uint32_t> refs;
+  if ( ps.streaming )
+  {
+    refs.resize( ntk.size(), 0u );
+    ntk.foreach_gate( [&]( auto const& n ) {
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        ++refs[ntk.node_to_index( ntk.get_node( f ) )];
+      } );
+    } );
+  }
+
+  {
+    stopwatch t( st.time_total );
+
+    ntk.foreach_node( [&]( auto const& n ) {
+      const auto index = ntk.node_to_index( n );
+      p.compute_cuts( n );
+
+      auto const& set = res.enumeration_cuts( index );
+      res.store( index, set );
+      if ( on_cuts )
+      {
+        on_cuts( n, set );
+      }
+      res.clear_staged();
+
+      if ( !ps.streaming )
+      {
+        return;
+      }
+      if ( !ntk.is_constant( n ) && !ntk.is_pi( n ) )
+      {
+        ntk.foreach_fanin( n, [&]( auto const& f ) {
+          const auto fi = ntk.node_to_index( ntk.get_node( f ) );
+          if ( --refs[fi] == 0u )
+          {
+            res.release( fi );
+          }
+        } );
+      }
+      if ( refs[index] == 0u )
+      {
+        res.release( index );
+      }
+    } );
+
+    res._total_tuples += p.num_tuples();
+    res._total_cuts += p.num_cuts();
+  }
+
+  if ( ps.verbose )
+  {
+    st.report();
+  }
+  if ( pst )
+  {
+    *pst = st;
+  }
+
+  return res;
+}
+
+} /* namespace mockturtle */
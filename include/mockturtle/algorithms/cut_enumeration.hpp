@@ -35,11 +35,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cstdint>
 #include <iostream>
+#include <iterator>
 #include <optional>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
 #include <vector>
 
 #include <kitty/constructors.hpp>
@@ -51,6 +56,7 @@
 #include "../utils/cuts.hpp"
 #include "../utils/mixed_radix.hpp"
 #include "../utils/stopwatch.hpp"
+#include "../utils/thread_barrier.hpp"
 #include "../utils/truth_table_cache.hpp"
 
 namespace mockturtle
@@ -75,6 +81,14 @@ struct cut_enumeration_params
   /*! \brief Prune cuts by removing don't cares. */
   bool minimize_truth_table{false};
 
+  /*! \brief Number of threads (0 for the number of hardware threads).
+   *
+   * With more than one thread, the nodes of each topological level are
+   * processed concurrently.  The resulting cuts and truth table literals
+   * are the same as with one thread.
+   */
+  uint32_t num_threads{1u};
+
   /*! \brief Be verbose. */
   bool verbose{false};
 
@@ -119,11 +133,140 @@ struct cut_data<false, T>
 template<bool ComputeTruth, typename T>
 using cut_type = cut<max_cut_size, cut_data<ComputeTruth, T>>;
 
+/*! \cond PRIVATE */
+namespace detail
+{
+
+/* Truth tables of a parallel cut enumeration, one shard per thread.
+ *
+ * Shard literals follow the convention of `truth_table_cache`: the indexes
+ * 0 and 1 refer to the constant and the projection in the cache of the
+ * cut database, and index 2 + i * S + s refers to entry i of shard s out of
+ * S shards.  New entries stay pending, and are only accessed by the owning
+ * thread, until `publish` is called while no other thread reads the shard.
+ *
+ * Each entry remembers its first use (node index, number of truth tables
+ * computed before for this node).  `merge` inserts the entries into the
+ * cache of the cut database in this order, which gives the same literals
+ * as a sequential enumeration.
+ */
+template<typename TT>
+class cut_truth_table_shards
+{
+public:
+  cut_truth_table_shards( truth_table_cache<TT>& global, uint32_t num_shards )
+      : _global( global ), _shards( num_shards )
+  {
+  }
+
+  TT operator[]( uint32_t lit ) const
+  {
+    const auto index = lit >> 1;
+    if ( index < 2u )
+    {
+      return _global[lit];
+    }
+
+    auto const& shard = _shards[( index - 2u ) % _shards.size()];
+    const auto local = ( index - 2u ) / _shards.size();
+    auto const& tt = local < shard.data.size() ? shard.data[local] : shard.pending[local - shard.data.size()];
+    return ( lit & 1 ) ? ~tt : tt;
+  }
+
+  uint32_t insert( uint32_t s, TT tt, uint64_t first_use )
+  {
+    uint32_t is_compl{0};
+    if ( kitty::get_bit( tt, 0 ) )
+    {
+      is_compl = 1;
+      tt = ~tt;
+    }
+
+    auto& shard = _shards[s];
+    uint32_t local;
+    if ( const auto it = shard.indexes.find( tt ); it != shard.indexes.end() )
+    {
+      local = it->second;
+      shard.first_use[local] = std::min( shard.first_use[local], first_use );
+    }
+    else
+    {
+      local = static_cast<uint32_t>( shard.first_use.size() );
+      shard.indexes.emplace( tt, local );
+      shard.pending.push_back( tt );
+      shard.first_use.push_back( first_use );
+    }
+
+    return 2u * ( 2u + local * static_cast<uint32_t>( _shards.size() ) + s ) + is_compl;
+  }
+
+  void publish( uint32_t s )
+  {
+    auto& shard = _shards[s];
+    std::move( shard.pending.begin(), shard.pending.end(), std::back_inserter( shard.data ) );
+    shard.pending.clear();
+  }
+
+  void merge()
+  {
+    std::vector<std::tuple<uint64_t, uint32_t, uint32_t>> entries;
+    for ( auto s = 0u; s < _shards.size(); ++s )
+    {
+      publish( s );
+      for ( auto i = 0u; i < _shards[s].data.size(); ++i )
+      {
+        entries.emplace_back( _shards[s].first_use[i], s, i );
+      }
+      _shards[s].global.resize( _shards[s].data.size() );
+    }
+    std::sort( entries.begin(), entries.end() );
+
+    for ( auto const& [first_use, s, i] : entries )
+    {
+      (void)first_use;
+      _shards[s].global[i] = _global.insert( _shards[s].data[i] );
+    }
+  }
+
+  /* literal in the cache of the cut database (after `merge`) */
+  uint32_t translate( uint32_t lit ) const
+  {
+    const auto index = lit >> 1;
+    if ( index < 2u )
+    {
+      return lit;
+    }
+    return _shards[( index - 2u ) % _shards.size()].global[( index - 2u ) / _shards.size()] ^ ( lit & 1 );
+  }
+
+private:
+  struct shard_t
+  {
+    std::unordered_map<TT, uint32_t, kitty::hash<TT>> indexes;
+    std::vector<TT> data;
+    std::vector<TT> pending;
+    std::vector<uint64_t> first_use;
+    std::vector<uint32_t> global;
+  };
+
+  truth_table_cache<TT>& _global;
+  std::vector<shard_t> _shards;
+};
+
+template<typename Ntk, typename NetworkCuts, typename Impl, typename TT>
+class parallel_cut_enumeration_impl;
+
+} /* namespace detail */
+/*! \endcond */
+
 /* forward declarations */
 /*! \cond PRIVATE */
 template<typename Ntk, bool ComputeTruth, typename CutData>
 struct network_cuts;
 
+template<typename Ntk, bool ComputeTruth, typename CutData>
+class cut_manager;
+
 template<typename Ntk, bool ComputeTruth = false, typename CutData = empty_cut_data>
 network_cuts<Ntk, ComputeTruth, CutData> cut_enumeration( Ntk const& ntk, cut_enumeration_params const& ps = {}, cut_enumeration_stats * pst = nullptr );
 
@@ -143,7 +286,7 @@ struct cut_enumeration_update_cut
 
 namespace detail
 {
-template<typename Ntk, bool ComputeTruth, typename CutData>
+template<typename Ntk, bool ComputeTruth, typename CutData, typename NetworkCuts = network_cuts<Ntk, ComputeTruth, CutData>>
 class cut_enumeration_impl;
 }
 /*! \endcond */
@@ -187,7 +330,7 @@ public:
   template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
   auto truth_table( cut_t const& cut ) const
   {
-    return _truth_tables[cut->func_id];
+    return _shards ? ( *_shards )[cut->func_id] : _truth_tables[cut->func_id];
   }
 
   /*! \brief Returns the total number of tuples that were tried to be merged */
@@ -243,13 +386,22 @@ public:
   }
 
 private:
-  template<typename _Ntk, bool _ComputeTruth, typename _CutData>
+  template<typename _Ntk, bool _ComputeTruth, typename _CutData, typename _NetworkCuts>
   friend class detail::cut_enumeration_impl;
 
+  template<typename _Ntk, typename _NetworkCuts, typename _Impl, typename _TT>
+  friend class detail::parallel_cut_enumeration_impl;
+
   template<typename _Ntk, bool _ComputeTruth, typename _CutData>
   friend network_cuts<_Ntk, _ComputeTruth, _CutData> cut_enumeration( _Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats * pst );
 
+  template<typename _Ntk, bool _ComputeTruth, typename _CutData>
+  friend class cut_manager;
+
 private:
+  /* cut set of a node during enumeration */
+  cut_set_t& enumeration_cuts( uint32_t index ) { return _cuts[index]; }
+
   void add_zero_cut( uint32_t index )
   {
     auto& cut = _cuts[index].add_cut( &index, &index ); /* fake iterator for emptyness */
@@ -277,6 +429,9 @@ private:
   /* cut truth tables */
   truth_table_cache<kitty::dynamic_truth_table> _truth_tables;
 
+  /* truth tables of a running parallel enumeration */
+  detail::cut_truth_table_shards<kitty::dynamic_truth_table>* _shards{nullptr};
+
   /* statistics */
   uint32_t _total_tuples{};
   std::size_t _total_cuts{};
@@ -286,14 +441,15 @@ private:
 namespace detail
 {
 
-template<typename Ntk, bool ComputeTruth, typename CutData>
+template<typename Ntk, bool ComputeTruth, typename CutData, typename NetworkCuts>
 class cut_enumeration_impl
 {
 public:
-  using cut_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_t;
-  using cut_set_t = typename network_cuts<Ntk, ComputeTruth, CutData>::cut_set_t;
+  using cut_t = typename NetworkCuts::cut_t;
+  using cut_set_t = typename NetworkCuts::cut_set_t;
+  using truth_table_t = kitty::dynamic_truth_table;
 
-  explicit cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, network_cuts<Ntk, ComputeTruth, CutData>& cuts )
+  explicit cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, NetworkCuts& cuts )
       : ntk( ntk ),
         ps( ps ),
         st( st ),
@@ -308,33 +464,59 @@ public:
     stopwatch t( st.time_total );
 
     ntk.foreach_node( [this]( auto node ) {
-      const auto index = ntk.node_to_index( node );
+      compute_cuts( node );
+    } );
 
-      if ( ps.very_verbose )
-      {
-        std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
-      }
+    cuts._total_tuples += total_tuples;
+    cuts._total_cuts += total_cuts;
+  }
 
-      if ( ntk.is_constant( node ) )
-      {
-        cuts.add_zero_cut( index );
-      }
-      else if ( ntk.is_pi( node ) )
+  void compute_cuts( node<Ntk> const& node )
+  {
+    const auto index = ntk.node_to_index( node );
+
+    if ( ps.very_verbose )
+    {
+      std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+    }
+
+    if ( ntk.is_constant( node ) )
+    {
+      cuts.add_zero_cut( index );
+    }
+    else if ( ntk.is_pi( node ) )
+    {
+      cuts.add_unit_cut( index );
+    }
+    else
+    {
+      first_use = uint64_t( index ) << 32;
+      if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
       {
-        cuts.add_unit_cut( index );
+        merge_cuts2( index );
       }
       else
       {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
-        {
-          merge_cuts2( index );
-        }
-        else
-        {
-          merge_cuts( index );
-        }
+        merge_cuts( index );
       }
-    } );
+    }
+  }
+
+  /* stores the computed truth tables into a shard */
+  void use_shard( cut_truth_table_shards<truth_table_t>* shards, uint32_t shard )
+  {
+    this->shards = shards;
+    this->shard = shard;
+  }
+
+  uint32_t num_tuples() const
+  {
+    return total_tuples;
+  }
+
+  std::size_t num_cuts() const
+  {
+    return total_cuts;
   }
 
 private:
@@ -346,7 +528,7 @@ private:
     auto i = 0;
     for ( auto const& cut : vcuts )
     {
-      tt[i] = kitty::extend_to( cuts._truth_tables[( *cut )->func_id], res.size() );
+      tt[i] = kitty::extend_to( cut_truth_table( ( *cut )->func_id ), res.size() );
       const auto supp = cuts.compute_truth_table_support( *cut, res );
       kitty::expand_inplace( tt[i], supp );
       ++i;
@@ -370,11 +552,21 @@ private:
           *it_leaves++ = leaves_before[*it_support++];
         }
         res.set_leaves( leaves_after.begin(), leaves_after.end() );
-        return cuts._truth_tables.insert( tt_res_shrink );
+        return insert_cut_truth_table( tt_res_shrink );
       }
     }
 
-    return cuts._truth_tables.insert( tt_res );
+    return insert_cut_truth_table( tt_res );
+  }
+
+  truth_table_t cut_truth_table( uint32_t lit ) const
+  {
+    return shards ? ( *shards )[lit] : cuts._truth_tables[lit];
+  }
+
+  uint32_t insert_cut_truth_table( truth_table_t const& tt )
+  {
+    return shards ? shards->insert( shard, tt, first_use++ ) : cuts._truth_tables.insert( tt );
   }
 
   void merge_cuts2( uint32_t index )
@@ -383,10 +575,10 @@ private:
 
     uint32_t pairs{1};
     ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs]( auto child, auto i ) {
-      lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
+      lcuts[i] = &cuts.enumeration_cuts( ntk.node_to_index( ntk.get_node( child ) ) );
       pairs *= static_cast<uint32_t>( lcuts[i]->size() );
     } );
-    lcuts[2] = &cuts.cuts( index );
+    lcuts[2] = &cuts.enumeration_cuts( index );
     auto& rcuts = *lcuts[fanin];
     rcuts.clear();
 
@@ -394,7 +586,7 @@ private:
 
     std::vector<cut_t const*> vcuts( fanin );
 
-    cuts._total_tuples += pairs;
+    total_tuples += pairs;
     for ( auto const& c1 : *lcuts[0] )
     {
       for ( auto const& c2 : *lcuts[1] )
@@ -425,7 +617,7 @@ private:
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_limit - 1 );
 
-    cuts._total_cuts += rcuts.size();
+    total_cuts += rcuts.size();
 
     if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
     {
@@ -438,13 +630,13 @@ private:
     uint32_t pairs{1};
     std::vector<uint32_t> cut_sizes;
     ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
-      lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
+      lcuts[i] = &cuts.enumeration_cuts( ntk.node_to_index( ntk.get_node( child ) ) );
       cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
       pairs *= cut_sizes.back();
     } );
 
     const auto fanin = cut_sizes.size();
-    lcuts[fanin] = &cuts.cuts( index );
+    lcuts[fanin] = &cuts.enumeration_cuts( index );
 
     auto& rcuts = *lcuts[fanin];
 
@@ -456,7 +648,7 @@ private:
 
       std::vector<cut_t const*> vcuts( fanin );
 
-      cuts._total_tuples += pairs;
+      total_tuples += pairs;
       foreach_mixed_radix_tuple( cut_sizes.begin(), cut_sizes.end(), [&]( auto begin, auto end ) {
         auto it = vcuts.begin();
         auto i = 0u;
@@ -518,7 +710,7 @@ private:
       rcuts.limit( ps.cut_limit - 1 );
     }
 
-    cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
+    total_cuts += static_cast<uint32_t>( rcuts.size() );
 
     cuts.add_unit_cut( index );
   }
@@ -527,9 +719,134 @@ private:
   Ntk const& ntk;
   cut_enumeration_params const& ps;
   cut_enumeration_stats& st;
-  network_cuts<Ntk, ComputeTruth, CutData>& cuts;
+  NetworkCuts& cuts;
 
   std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+
+  cut_truth_table_shards<truth_table_t>* shards{nullptr};
+  uint32_t shard{0u};
+  uint64_t first_use{0u};
+
+  uint32_t total_tuples{};
+  std::size_t total_cuts{};
+};
+
+/* Enumerates the cuts of the nodes of each topological level concurrently.
+ * Each thread computes truth tables into its own shard, which are merged
+ * into the cut database at the end in the order of a sequential run.
+ */
+template<typename Ntk, typename NetworkCuts, typename Impl, typename TT>
+class parallel_cut_enumeration_impl
+{
+public:
+  explicit parallel_cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, NetworkCuts& cuts, uint32_t num_threads )
+      : ntk( ntk ),
+        ps( ps ),
+        st( st ),
+        cuts( cuts ),
+        num_threads( num_threads ),
+        thread_st( num_threads ),
+        shards( cuts._truth_tables, num_threads )
+  {
+    impls.reserve( num_threads );
+    for ( auto i = 0u; i < num_threads; ++i )
+    {
+      impls.emplace_back( ntk, ps, thread_st[i], cuts );
+      impls.back().use_shard( &shards, i );
+    }
+  }
+
+public:
+  void run()
+  {
+    stopwatch t( st.time_total );
+
+    const auto levels = compute_levels();
+
+    cuts._shards = &shards;
+    thread_barrier barrier( num_threads );
+    std::vector<std::thread> threads;
+    for ( auto i = 0u; i < num_threads; ++i )
+    {
+      threads.emplace_back( [&, i]() {
+        for ( auto const& gates : levels )
+        {
+          /* contiguous chunks keep neighbouring nodes in one thread */
+          const auto chunk = ( gates.size() + num_threads - 1u ) / num_threads;
+          const auto end = std::min<std::size_t>( gates.size(), ( i + 1u ) * chunk );
+          for ( auto j = i * chunk; j < end; ++j )
+          {
+            impls[i].compute_cuts( ntk.index_to_node( gates[j] ) );
+          }
+          barrier.wait();
+          shards.publish( i );
+          barrier.wait();
+        }
+      } );
+    }
+    for ( auto& thread : threads )
+    {
+      thread.join();
+    }
+    cuts._shards = nullptr;
+
+    if constexpr ( NetworkCuts::compute_truth )
+    {
+      shards.merge();
+      for ( auto const& set : cuts._cuts )
+      {
+        for ( auto* cut : set )
+        {
+          ( *cut )->func_id = shards.translate( ( *cut )->func_id );
+        }
+      }
+    }
+
+    for ( auto i = 0u; i < num_threads; ++i )
+    {
+      cuts._total_tuples += impls[i].num_tuples();
+      cuts._total_cuts += impls[i].num_cuts();
+      st.time_truth_table += thread_st[i].time_truth_table;
+    }
+  }
+
+private:
+  /* computes the cuts of constants and PIs, and groups the gates by level */
+  std::vector<std::vector<uint32_t>> compute_levels()
+  {
+    std::vector<std::vector<uint32_t>> levels;
+    std::vector<uint32_t> level( ntk.size(), 0u );
+    ntk.foreach_node( [&]( auto const& n ) {
+      if ( ntk.is_constant( n ) || ntk.is_pi( n ) )
+      {
+        impls[0].compute_cuts( n );
+        return;
+      }
+
+      uint32_t l{0};
+      ntk.foreach_fanin( n, [&]( auto const& f ) {
+        l = std::max( l, level[ntk.node_to_index( ntk.get_node( f ) )] );
+      } );
+      level[ntk.node_to_index( n )] = l + 1u;
+      if ( levels.size() <= l )
+      {
+        levels.resize( l + 1u );
+      }
+      levels[l].push_back( ntk.node_to_index( n ) );
+    } );
+    return levels;
+  }
+
+private:
+  Ntk const& ntk;
+  cut_enumeration_params const& ps;
+  cut_enumeration_stats& st;
+  NetworkCuts& cuts;
+  uint32_t num_threads;
+
+  std::vector<cut_enumeration_stats> thread_st;
+  cut_truth_table_shards<TT> shards;
+  std::vector<Impl> impls;
 };
 } /* namespace detail */
 /*! \endcond */
@@ -556,6 +873,11 @@ private:
  * application specific cut data can be found in the files contained in the
  * directory `include/mockturtle/algorithms/cut_enumeration`.
  *
+ * With `num_threads` greater than one, the nodes of each level are
+ * distributed among threads, which call the network functions (and
+ * `cut_enumeration_update_cut`) concurrently.  The cut database is the same
+ * as the one of a sequential run.
+ *
  * **Required network functions:**
  * - `is_constant`
  * - `is_pi`
@@ -595,8 +917,17 @@ network_cuts<Ntk, ComputeTruth, CutData> cut_enumeration( Ntk const& ntk, cut_en
 
   cut_enumeration_stats st;
   network_cuts<Ntk, ComputeTruth, CutData> res( ntk.size() );
-  detail::cut_enumeration_impl<Ntk, ComputeTruth, CutData> p( ntk, ps, st, res );
-  p.run();
+  const auto num_threads = ps.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.num_threads;
+  if ( num_threads > 1u )
+  {
+    detail::parallel_cut_enumeration_impl<Ntk, network_cuts<Ntk, ComputeTruth, CutData>, detail::cut_enumeration_impl<Ntk, ComputeTruth, CutData>, kitty::dynamic_truth_table> p( ntk, ps, st, res, num_threads );
+    p.run();
+  }
+  else
+  {
+    detail::cut_enumeration_impl<Ntk, ComputeTruth, CutData> p( ntk, ps, st, res );
+    p.run();
+  }
 
   if ( ps.verbose )
   {
@@ -632,7 +963,9 @@ class fast_cut_enumeration_impl;
  * node, or the function of a cut (if it was computed).
  *
  * Comparing to `network_cuts`, it uses static truth tables instead of
- * dynamic truth tables to speed-up the truth table computation.
+ * dynamic truth tables to speed-up the truth table computation.  For up to 6
+ * variables, the truth tables are single words in a flat hash table, and no
+ * memory is allocated for each cut.
  * 
  * An instance of type `fast_network_cuts` can only be constructed from the
  * `fast_cut_enumeration` algorithm.
@@ -667,7 +1000,7 @@ public:
   template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
   auto truth_table( cut_t const& cut ) const
   {
-    return _truth_tables[cut->func_id];
+    return _shards ? ( *_shards )[cut->func_id] : _truth_tables[cut->func_id];
   }
 
   /*! \brief Returns the total number of tuples that were tried to be merged */
@@ -726,6 +1059,9 @@ private:
   template<typename _Ntk, uint32_t _NumVars, bool _ComputeTruth, typename _CutData>
   friend class detail::fast_cut_enumeration_impl;
 
+  template<typename _Ntk, typename _NetworkCuts, typename _Impl, typename _TT>
+  friend class detail::parallel_cut_enumeration_impl;
+
   template<typename _Ntk, uint32_t _NumVars, bool _ComputeTruth, typename _CutData>
   friend fast_network_cuts<_Ntk, _NumVars, _ComputeTruth, _CutData> fast_cut_enumeration( _Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats * pst );
 
@@ -757,6 +1093,9 @@ private:
   /* cut truth tables */
   truth_table_cache<kitty::static_truth_table<NumVars>> _truth_tables;
 
+  /* truth tables of a running parallel enumeration */
+  detail::cut_truth_table_shards<kitty::static_truth_table<NumVars>>* _shards{nullptr};
+
   /* statistics */
   uint32_t _total_tuples{};
   std::size_t _total_cuts{};
@@ -772,6 +1111,7 @@ class fast_cut_enumeration_impl
 public:
   using cut_t = typename fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>::cut_t;
   using cut_set_t = typename fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>::cut_set_t;
+  using truth_table_t = kitty::static_truth_table<NumVars>;
 
   explicit fast_cut_enumeration_impl( Ntk const& ntk, cut_enumeration_params const& ps, cut_enumeration_stats& st, fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>& cuts )
       : ntk( ntk ),
@@ -788,33 +1128,59 @@ public:
     stopwatch t( st.time_total );
 
     ntk.foreach_node( [this]( auto node ) {
-      const auto index = ntk.node_to_index( node );
+      compute_cuts( node );
+    } );
 
-      if ( ps.very_verbose )
-      {
-        std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
-      }
+    cuts._total_tuples += total_tuples;
+    cuts._total_cuts += total_cuts;
+  }
 
-      if ( ntk.is_constant( node ) )
-      {
-        cuts.add_zero_cut( index );
-      }
-      else if ( ntk.is_pi( node ) )
+  void compute_cuts( node<Ntk> const& node )
+  {
+    const auto index = ntk.node_to_index( node );
+
+    if ( ps.very_verbose )
+    {
+      std::cout << fmt::format( "[i] compute cut for node at index {}\n", index );
+    }
+
+    if ( ntk.is_constant( node ) )
+    {
+      cuts.add_zero_cut( index );
+    }
+    else if ( ntk.is_pi( node ) )
+    {
+      cuts.add_unit_cut( index );
+    }
+    else
+    {
+      first_use = uint64_t( index ) << 32;
+      if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
       {
-        cuts.add_unit_cut( index );
+        merge_cuts2( index );
       }
       else
       {
-        if constexpr ( Ntk::min_fanin_size == 2 && Ntk::max_fanin_size == 2 )
-        {
-          merge_cuts2( index );
-        }
-        else
-        {
-          merge_cuts( index );
-        }
+        merge_cuts( index );
       }
-    } );
+    }
+  }
+
+  /* stores the computed truth tables into a shard */
+  void use_shard( cut_truth_table_shards<truth_table_t>* shards, uint32_t shard )
+  {
+    this->shards = shards;
+    this->shard = shard;
+  }
+
+  uint32_t num_tuples() const
+  {
+    return total_tuples;
+  }
+
+  std::size_t num_cuts() const
+  {
+    return total_cuts;
   }
 
 private:
@@ -822,37 +1188,81 @@ private:
   {
     stopwatch t( st.time_truth_table );
 
-    std::vector<kitty::static_truth_table<NumVars>> tt( vcuts.size() );
-    auto i = 0;
+    /* fanin functions in reused buffers, no allocation for each cut */
+    fanin_tts.resize( vcuts.size() );
+    auto i = 0u;
     for ( auto const& cut : vcuts )
     {
-      tt[i] = cuts._truth_tables[( *cut )->func_id];
-      const auto supp = cuts.compute_truth_table_support( *cut, res );
-      kitty::expand_inplace( tt[i], supp );
-      ++i;
+      fanin_tts[i] = cut_truth_table( ( *cut )->func_id );
+      expand_to_cut( fanin_tts[i++], *cut, res );
     }
 
-    auto tt_res = ntk.compute( ntk.index_to_node( index ), tt.begin(), tt.end() );
+    auto tt_res = ntk.compute( ntk.index_to_node( index ), fanin_tts.begin(), fanin_tts.end() );
 
     if ( ps.minimize_truth_table )
     {
-      const auto support = kitty::min_base_inplace( tt_res );
-      if ( support.size() != res.size() )
+      minimize_cut( tt_res, res );
+    }
+
+    return insert_cut_truth_table( tt_res );
+  }
+
+  /* moves the variables of `tt` over the leaves of `sub` to the positions of
+   * the same leaves in `sup` (as `kitty::expand_inplace` with the support of
+   * `compute_truth_table_support`) */
+  static void expand_to_cut( truth_table_t& tt, cut_t const& sub, cut_t const& sup )
+  {
+    std::array<uint8_t, NumVars> support;
+    auto itp = sup.begin();
+    auto num_vars = 0u;
+    for ( auto i : sub )
+    {
+      itp = std::find( itp, sup.end(), i );
+      support[num_vars++] = static_cast<uint8_t>( std::distance( sup.begin(), itp ) );
+    }
+
+    for ( auto i = num_vars; i-- > 0u; )
+    {
+      if ( support[i] != i )
       {
-        std::vector<uint32_t> leaves_before( res.begin(), res.end() );
-        std::vector<uint32_t> leaves_after( support.size() );
+        kitty::swap_inplace( tt, static_cast<uint8_t>( i ), support[i] );
+      }
+    }
+  }
 
-        auto it_support = support.begin();
-        auto it_leaves = leaves_after.begin();
-        while ( it_support != support.end() )
-        {
-          *it_leaves++ = leaves_before[*it_support++];
-        }
-        res.set_leaves( leaves_after.begin(), leaves_after.end() );
+  /* removes the leaves of `res` outside the support of `tt` (as
+   * `kitty::min_base_inplace`) */
+  static void minimize_cut( truth_table_t& tt, cut_t& res )
+  {
+    std::array<uint32_t, NumVars> leaves;
+    auto k = 0u;
+    for ( auto i = 0u; i < res.size(); ++i )
+    {
+      if ( !kitty::has_var( tt, i ) )
+      {
+        continue;
       }
+      if ( k < i )
+      {
+        kitty::swap_inplace( tt, static_cast<uint8_t>( k ), static_cast<uint8_t>( i ) );
+      }
+      leaves[k++] = *( res.begin() + i );
+    }
+
+    if ( k != res.size() )
+    {
+      res.set_leaves( leaves.begin(), leaves.begin() + k );
     }
+  }
 
-    return cuts._truth_tables.insert( tt_res );
+  truth_table_t cut_truth_table( uint32_t lit ) const
+  {
+    return shards ? ( *shards )[lit] : cuts._truth_tables[lit];
+  }
+
+  uint32_t insert_cut_truth_table( truth_table_t const& tt )
+  {
+    return shards ? shards->insert( shard, tt, first_use++ ) : cuts._truth_tables.insert( tt );
   }
 
   void merge_cuts2( uint32_t index )
@@ -870,9 +1280,9 @@ private:
 
     cut_t new_cut;
 
-    std::vector<cut_t const*> vcuts( fanin );
+    vcuts.resize( fanin );
 
-    cuts._total_tuples += pairs;
+    total_tuples += pairs;
     for ( auto const& c1 : *lcuts[0] )
     {
       for ( auto const& c2 : *lcuts[1] )
@@ -903,7 +1313,7 @@ private:
     /* limit the maximum number of cuts */
     rcuts.limit( ps.cut_limit - 1 );
 
-    cuts._total_cuts += rcuts.size();
+    total_cuts += rcuts.size();
 
     if ( rcuts.size() > 1 || ( *rcuts.begin() )->size() > 1 )
     {
@@ -914,8 +1324,8 @@ private:
   void merge_cuts( uint32_t index )
   {
     uint32_t pairs{1};
-    std::vector<uint32_t> cut_sizes;
-    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs, &cut_sizes]( auto child, auto i ) {
+    cut_sizes.clear();
+    ntk.foreach_fanin( ntk.index_to_node( index ), [this, &pairs]( auto child, auto i ) {
       lcuts[i] = &cuts.cuts( ntk.node_to_index( ntk.get_node( child ) ) );
       cut_sizes.push_back( static_cast<uint32_t>( lcuts[i]->size() ) );
       pairs *= cut_sizes.back();
@@ -932,9 +1342,9 @@ private:
 
       cut_t new_cut, tmp_cut;
 
-      std::vector<cut_t const*> vcuts( fanin );
+      vcuts.resize( fanin );
 
-      cuts._total_tuples += pairs;
+      total_tuples += pairs;
       foreach_mixed_radix_tuple( cut_sizes.begin(), cut_sizes.end(), [&]( auto begin, auto end ) {
         auto it = vcuts.begin();
         auto i = 0u;
@@ -979,12 +1389,14 @@ private:
     } else if ( fanin == 1 ) {
       rcuts.clear();
 
+      vcuts.resize( 1u );
       for ( auto const& cut : *lcuts[0] ) {
         cut_t new_cut = *cut;
 
         if constexpr ( ComputeTruth )
         {
-          new_cut->func_id = compute_truth_table( index, {cut}, new_cut );
+          vcuts[0] = cut;
+          new_cut->func_id = compute_truth_table( index, vcuts, new_cut );
         }
 
         cut_enumeration_update_cut<CutData>::apply( new_cut, cuts, ntk, ntk.index_to_node( index ) );
@@ -996,7 +1408,7 @@ private:
       rcuts.limit( ps.cut_limit - 1 );
     }
 
-    cuts._total_cuts += static_cast<uint32_t>( rcuts.size() );
+    total_cuts += static_cast<uint32_t>( rcuts.size() );
 
     cuts.add_unit_cut( index );
   }
@@ -1008,6 +1420,16 @@ private:
   fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>& cuts;
 
   std::array<cut_set_t*, Ntk::max_fanin_size + 1> lcuts;
+  std::vector<truth_table_t> fanin_tts;
+  std::vector<cut_t const*> vcuts;
+  std::vector<uint32_t> cut_sizes;
+
+  cut_truth_table_shards<truth_table_t>* shards{nullptr};
+  uint32_t shard{0u};
+  uint64_t first_use{0u};
+
+  uint32_t total_tuples{};
+  std::size_t total_cuts{};
 };
 } /* namespace detail */
 /*! \endcond */
@@ -1040,6 +1462,11 @@ private:
  * application specific cut data can be found in the files contained in the
  * directory `include/mockturtle/algorithms/cut_enumeration`.
  *
+ * With `num_threads` greater than one, the nodes of each level are
+ * distributed among threads, which call the network functions (and
+ * `cut_enumeration_update_cut`) concurrently.  The cut database is the same
+ * as the one of a sequential run.
+ *
  * **Required network functions:**
  * - `is_constant`
  * - `is_pi`
@@ -1079,8 +1506,17 @@ fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData> fast_cut_enumeration( Ntk
 
   cut_enumeration_stats st;
   fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData> res( ntk.size() );
-  detail::fast_cut_enumeration_impl<Ntk, NumVars, ComputeTruth, CutData> p( ntk, ps, st, res );
-  p.run();
+  const auto num_threads = ps.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.num_threads;
+  if ( num_threads > 1u )
+  {
+    detail::parallel_cut_enumeration_impl<Ntk, fast_network_cuts<Ntk, NumVars, ComputeTruth, CutData>, detail::fast_cut_enumeration_impl<Ntk, NumVars, ComputeTruth, CutData>, kitty::static_truth_table<NumVars>> p( ntk, ps, st, res, num_threads );
+    p.run();
+  }
+  else
+  {
+    detail::fast_cut_enumeration_impl<Ntk, NumVars, ComputeTruth, CutData> p( ntk, ps, st, res );
+    p.run();
+  }
 
   if ( ps.verbose )
   {
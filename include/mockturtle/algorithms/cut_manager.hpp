@@ -0,0 +1,284 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file cut_manager.hpp
+  \brief Cut enumeration that follows network edits
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/fanout_tracker.hpp"
+#include "../utils/node_map.hpp"
+#include "cut_enumeration.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Cut database that stays valid while the network is edited.
+ *
+ * The cut manager holds the same cut sets as `cut_enumeration` with the
+ * same parameters, but computes a cut set only when it is requested, after
+ * the cut sets of the node's fanins.
+ *
+ * When the fanins of a node change, the cuts of the node and of its
+ * transitive fanout may no longer be valid, and their cut sets are computed
+ * again on the next request; cuts of all other nodes stay valid and are
+ * kept.  Therefore, the network does not need to be in topological order,
+ * and several rounds of rewriting can share one cut database.
+ *
+ * Truth tables of recomputed cuts are added to the truth table cache, which
+ * is never cleared.  Creating nodes may invalidate references to cut sets.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `events`
+ * - `get_node`
+ * - `node_to_index`
+ * - `index_to_node`
+ * - `is_constant`
+ * - `is_pi`
+ * - `foreach_node`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `compute` for `kitty::dynamic_truth_table` (if `ComputeTruth` is true)
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      cut_manager<aig_network, true> cuts{aig, ps};
+
+      for ( auto const& cut : cuts.cuts( n ) ) { ... }
+      aig.substitute_node( n, f );   // marks the fanout of n as out of date
+      for ( auto const& cut : cuts.cuts( m ) ) { ... }   // recomputed if m depends on n
+   \endverbatim
+ */
+template<typename Ntk, bool ComputeTruth = false, typename CutData = empty_cut_data>
+class cut_manager
+{
+public:
+  using node = typename Ntk::node;
+  using network_cuts_t = network_cuts<Ntk, ComputeTruth, CutData>;
+  using cut_t = typename network_cuts_t::cut_t;
+  using cut_set_t = typename network_cuts_t::cut_set_t;
+
+  explicit cut_manager( Ntk const& ntk, cut_enumeration_params const& ps = {} )
+      : _ntk( ntk ),
+        _ps( ps ),
+        _cuts( ntk.size() ),
+        _impl( ntk, _ps, _st, _cuts ),
+        _dirty( ntk, 0u )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( !ComputeTruth || has_compute_v<Ntk, kitty::dynamic_truth_table>, "Ntk does not implement the compute method for kitty::dynamic_truth_table" );
+
+    ntk.foreach_node( [&]( auto const& n ) {
+      set_dirty( n );
+    } );
+    track_events();
+  }
+
+  cut_manager( cut_manager const& ) = delete;
+  cut_manager& operator=( cut_manager const& ) = delete;
+
+  /*! \brief Returns the cut set of `n`, computes it if it is out of date. */
+  cut_set_t const& cuts( node const& n )
+  {
+    compute( n );
+    return _cuts.cuts( _ntk.node_to_index( n ) );
+  }
+
+  /*! \brief Returns the truth table of a cut. */
+  template<bool enabled = ComputeTruth, typename = std::enable_if_t<std::is_same_v<Ntk, Ntk> && enabled>>
+  auto truth_table( cut_t const& cut ) const
+  {
+    return _cuts.truth_table( cut );
+  }
+
+  /*! \brief Computes all cut sets that are out of date.
+   *
+   * Afterwards, `database` contains the cut sets of all nodes.
+   */
+  void update()
+  {
+    for ( auto i = 0u; i < _pending.size(); ++i )
+    {
+      compute( _pending[i] );
+    }
+    _pending.clear();
+  }
+
+  /*! \brief Returns the cut database (only up to date after `update`). */
+  network_cuts_t const& database() const
+  {
+    return _cuts;
+  }
+
+  /*! \brief Returns whether the cut set of `n` is out of date. */
+  bool is_dirty( node const& n ) const
+  {
+    return _dirty[n] != 0u;
+  }
+
+  /*! \brief Returns the number of nodes with out-of-date cut sets. */
+  uint32_t num_dirty() const
+  {
+    return _num_dirty;
+  }
+
+  /*! \brief Returns the number of cut sets computed so far (initially or again). */
+  uint64_t num_computed() const
+  {
+    return _num_computed;
+  }
+
+  /*! \brief Returns the time statistics of all computations so far. */
+  cut_enumeration_stats const& stats() const
+  {
+    return _st;
+  }
+
+private:
+  /* computes the cut set of `n` after the ones of its out-of-date fanins */
+  void compute( node const& root )
+  {
+    if ( !_dirty[root] )
+    {
+      return;
+    }
+
+    stopwatch t( _st.time_total );
+    _stack.emplace_back( root, false );
+    while ( !_stack.empty() )
+    {
+      const auto [n, expanded] = _stack.back();
+      _stack.pop_back();
+      if ( !_dirty[n] )
+      {
+        continue;
+      }
+      if ( expanded )
+      {
+        _cuts.cuts( _ntk.node_to_index( n ) ).clear();
+        _impl.compute_cuts( n );
+        _dirty[n] = 0u;
+        --_num_dirty;
+        ++_num_computed;
+        continue;
+      }
+
+      /* the fanins are computed before `n` is popped again (the network is acyclic) */
+      _stack.emplace_back( n, true );
+      if ( !_ntk.is_constant( n ) && !_ntk.is_pi( n ) )
+      {
+        _ntk.foreach_fanin( n, [&]( auto const& f ) {
+          if ( _dirty[_ntk.get_node( f )] )
+          {
+            _stack.emplace_back( _ntk.get_node( f ), false );
+          }
+        } );
+      }
+    }
+  }
+
+  /* returns whether `n` has been marked now */
+  bool set_dirty( node const& n )
+  {
+    if ( _dirty[n] )
+    {
+      return false;
+    }
+
+    _dirty[n] = 1u;
+    ++_num_dirty;
+    _pending.push_back( n );
+
+    /* `cuts` computes nodes without removing them from `_pending` */
+    if ( _pending.size() > 2u * _num_dirty )
+    {
+      _pending.erase( std::remove_if( _pending.begin(), _pending.end(), [&]( auto const& m ) { return !_dirty[m]; } ), _pending.end() );
+    }
+    return true;
+  }
+
+  void track_events()
+  {
+    _tracker.build( _ntk );
+    _tracker.track(
+        _ntk,
+        [this]( auto const& n ) {
+          _cuts._cuts.resize( _ntk.size() );
+          _dirty.resize( 0u );
+          set_dirty( n );
+        },
+        [this]( auto const& n ) {
+          /* the fanout of an out-of-date node is out of date, too */
+          _tracker.mark_tfo( n, [this]( auto const& m ) { return set_dirty( m ); } );
+        },
+        [this]( auto const& n ) {
+          _cuts.cuts( _ntk.node_to_index( n ) ).clear();
+          if ( _dirty[n] )
+          {
+            _dirty[n] = 0u;
+            --_num_dirty;
+          }
+        } );
+  }
+
+private:
+  Ntk const& _ntk;
+  cut_enumeration_params _ps;
+  cut_enumeration_stats _st;
+  uint64_t _num_computed{0u};
+
+  network_cuts_t _cuts;
+  detail::cut_enumeration_impl<Ntk, ComputeTruth, CutData> _impl;
+
+  node_map<uint8_t, Ntk> _dirty;
+  uint32_t _num_dirty{0u};
+  std::vector<node> _pending;
+  std::vector<std::pair<node, bool>> _stack;
+  detail::fanout_tracker<Ntk> _tracker;
+};
+
+} // namespace mockturtle
@@ -34,10 +34,7 @@
 
 #include <vector>
 
-#include "../simulation.hpp"
-
-#include <kitty/bit_operations.hpp>
-#include <kitty/partial_truth_table.hpp>
+#include "../switching_activity.hpp"
 
 namespace mockturtle::detail
 {
@@ -45,26 +42,21 @@ namespace mockturtle::detail
 /*! \brief Switching Activity.
  *
  * This function computes the switching activity for each node
- * in the network by performing random simulation.
+ * in the network by performing random simulation (see
+ * `switching_activity_engine`).
  *
  * \param ntk Network
  * \param simulation_size Number of simulation bits
+ * \param num_threads Number of simulation threads (0 for the number of hardware threads)
  */
 template<typename Ntk>
-std::vector<float> switching_activity( Ntk const& ntk, unsigned simulation_size = 2048 )
+std::vector<float> switching_activity( Ntk const& ntk, unsigned simulation_size = 2048, uint32_t num_threads = 1u )
 {
-  std::vector<float> sw_map( ntk.size() );
-  partial_simulator sim( ntk.num_pis(), simulation_size );
-
-  auto tts = simulate_nodes<kitty::partial_truth_table, Ntk, partial_simulator>( ntk, sim );
-
-  ntk.foreach_node( [&]( auto const& n ) {
-    float ones = static_cast<float>( kitty::count_ones( tts[n] ) );
-    float activity = 2.0 * ones / simulation_size * ( simulation_size - ones ) / simulation_size;
-    sw_map[ntk.node_to_index( n )] = activity;
-  } );
-
-  return sw_map;
+  switching_activity_params ps;
+  ps.num_patterns = simulation_size;
+  ps.num_threads = num_threads;
+  switching_activity_engine<Ntk> engine( ntk, ps );
+  return engine.activities();
 }
 
 } // namespace mockturtle::detail
\ No newline at end of file
@@ -0,0 +1,415 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file fault_simulation.hpp
+  \brief Bit-parallel stuck-at fault simulation
+*/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/stopwatch.hpp"
+#include "simulation.hpp"
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+struct fault_simulation_params
+{
+  /*! \brief Maximum number of gates evaluated when simulating a fanout stem (0 = no limit).
+   *
+   * When the limit is reached, only the patterns under which a change of
+   * the stem has already reached an output are considered observable.
+   */
+  uint32_t max_events{0u};
+};
+
+struct fault_simulation_stats
+{
+  /*! \brief Total time. */
+  stopwatch<>::duration time_total{0};
+
+  /*! \brief Time for event-driven simulation of fanout stems. */
+  stopwatch<>::duration time_stems{0};
+
+  /*! \brief Number of fanout stems. */
+  uint32_t num_stems{0};
+
+  /*! \brief Number of stems whose events converged into a single node. */
+  uint32_t num_converged_stems{0};
+
+  /*! \brief Number of stems whose simulation stopped at `max_events`. */
+  uint32_t num_aborted_stems{0};
+};
+
+/*! \brief Stuck-at fault simulator.
+ *
+ * Computes, for every primary input and gate `n`, the patterns of a
+ * `partial_simulator` under which a change of the value of `n` is
+ * observable at a primary output.  The stuck-at-0 fault at `n` is
+ * detected by the observable patterns in which `n` is 1, and the
+ * stuck-at-1 fault by the observable patterns in which `n` is 0.
+ *
+ * All patterns are simulated in parallel.  Nodes are processed in reverse
+ * topological order: the observability of a node with a single fanout is
+ * derived from the observability of its fanout and the sensitivity of the
+ * fanout to it (critical path tracing), such that all faults in a
+ * fanout-free region are simulated in one pass.  Fanout stems are
+ * simulated event-driven, until the events reach the outputs or converge
+ * into a single node whose observability is known.
+ *
+ * With `max_events`, the observability is under-approximated: every
+ * pattern reported to detect a fault does detect it, but some detected
+ * faults may be missed.
+ *
+ * The network is expected to be topologically sorted.
+ *
+ * **Required network functions:**
+ * - `get_node`
+ * - `is_constant`
+ * - `foreach_pi`
+ * - `foreach_po`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `compute<kitty::partial_truth_table>`
+ */
+template<class Ntk>
+class fault_simulator
+{
+public:
+  using node = typename Ntk::node;
+
+  fault_simulator( Ntk const& ntk, partial_simulator const& sim, fault_simulation_params const& ps = {}, fault_simulation_stats* pst = nullptr )
+      : _ntk( ntk ),
+        _ps( ps ),
+        _pst( pst ),
+        _tts( simulate_nodes<kitty::partial_truth_table>( ntk, sim ) ),
+        _observability( ntk ),
+        _faulty( ntk ),
+        _event( ntk, 0u ),
+        _position( ntk, 0u ),
+        _first_fanout( ntk, 0u ),
+        _num_fanouts( ntk, 0u ),
+        _num_po_refs( ntk, 0u )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+    static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute method for kitty::partial_truth_table" );
+
+    _num_bits = sim.num_bits();
+    init();
+  }
+
+  /*! \brief Computes the observability of all nodes. */
+  void run()
+  {
+    fault_simulation_stats st;
+    call_with_stopwatch( st.time_total, [&]() {
+      kitty::partial_truth_table const zero( _num_bits );
+      for ( auto it = _order.rbegin(); it != _order.rend(); ++it )
+      {
+        auto const& n = *it;
+        if ( _num_po_refs[n] > 0u )
+        {
+          _observability[n] = ~zero;
+        }
+        else if ( _num_fanouts[n] == 0u )
+        {
+          _observability[n] = zero;
+        }
+        else if ( _num_fanouts[n] == 1u )
+        {
+          auto const& g = _fanouts[_first_fanout[n]];
+          _observability[n] = _observability[g] & sensitivity( g, n );
+        }
+        else
+        {
+          ++st.num_stems;
+          _observability[n] = call_with_stopwatch( st.time_stems, [&]() {
+            return simulate_stem( n, st );
+          } );
+        }
+      }
+    } );
+
+    if ( _pst )
+    {
+      *_pst = st;
+    }
+  }
+
+  /*! \brief Returns the patterns under which a change of `n` is observable. */
+  kitty::partial_truth_table const& observability( node const& n ) const
+  {
+    return _observability[n];
+  }
+
+  /*! \brief Returns the patterns detecting the fault `n` stuck at `value`. */
+  kitty::partial_truth_table detecting_patterns( node const& n, bool value ) const
+  {
+    return value ? _observability[n] & ~_tts[n] : _observability[n] & _tts[n];
+  }
+
+  /*! \brief Checks whether some pattern detects the fault `n` stuck at `value`. */
+  bool is_detected( node const& n, bool value ) const
+  {
+    return !kitty::is_const0( detecting_patterns( n, value ) );
+  }
+
+  /*! \brief Returns the number of stuck-at faults at primary inputs and gates. */
+  uint32_t num_faults() const
+  {
+    return 2u * static_cast<uint32_t>( _order.size() );
+  }
+
+  /*! \brief Returns the number of detected stuck-at faults. */
+  uint32_t num_detected_faults() const
+  {
+    uint32_t count{0u};
+    for ( auto const& n : _order )
+    {
+      count += is_detected( n, false ) ? 1u : 0u;
+      count += is_detected( n, true ) ? 1u : 0u;
+    }
+    return count;
+  }
+
+  /*! \brief Returns the simulation value of `n`. */
+  kitty::partial_truth_table const& value( node const& n ) const
+  {
+    return _tts[n];
+  }
+
+private:
+  void init()
+  {
+    _ntk.foreach_pi( [&]( auto const& n ) {
+      _position[n] = static_cast<uint32_t>( _order.size() );
+      _order.emplace_back( n );
+    } );
+    _ntk.foreach_gate( [&]( auto const& n ) {
+      _position[n] = static_cast<uint32_t>( _order.size() );
+      _order.emplace_back( n );
+      _ntk.foreach_fanin( n, [&]( auto const& f ) {
+        if ( !_ntk.is_constant( _ntk.get_node( f ) ) )
+        {
+          ++_num_fanouts[_ntk.get_node( f )];
+        }
+      } );
+    } );
+    _ntk.foreach_po( [&]( auto const& f ) {
+      ++_num_po_refs[_ntk.get_node( f )];
+    } );
+
+    /* fanouts in CSR format */
+    uint32_t offset{0u};
+    for ( auto const& n : _order )
+    {
+      _first_fanout[n] = offset;
+      offset += _num_fanouts[n];
+      _num_fanouts[n] = 0u;
+    }
+    _fanouts.resize( offset );
+    _ntk.foreach_gate( [&]( auto const& n ) {
+      _ntk.foreach_fanin( n, [&]( auto const& f ) {
+        auto const child = _ntk.get_node( f );
+        if ( !_ntk.is_constant( child ) )
+        {
+          _fanouts[_first_fanout[child] + _num_fanouts[child]++] = n;
+        }
+      } );
+    } );
+  }
+
+  /* patterns under which a change of fanin `n` changes `g` */
+  kitty::partial_truth_table sensitivity( node const& g, node const& n )
+  {
+    _fanin_values.resize( _ntk.fanin_size( g ) );
+    _ntk.foreach_fanin( g, [&]( auto const& f, auto i ) {
+      auto const child = _ntk.get_node( f );
+      _fanin_values[i] = child == n ? ~_tts[child] : _tts[child];
+    } );
+    return _ntk.compute( g, _fanin_values.begin(), _fanin_values.end() ) ^ _tts[g];
+  }
+
+  /* reads the faulty values of the current stem and writes into a scratch truth table */
+  struct faulty_values
+  {
+    kitty::partial_truth_table& operator[]( node const& n )
+    {
+      if ( n == target )
+      {
+        return result;
+      }
+      return sim._event[n] == sim._stamp ? sim._faulty[n] : sim._tts[n];
+    }
+
+    fault_simulator& sim;
+    node target;
+    kitty::partial_truth_table& result;
+  };
+
+  /* computes the faulty value of `g` into `result` */
+  void faulty_value( node const& g, kitty::partial_truth_table& result )
+  {
+    faulty_values values{*this, g, result};
+    if ( detail::compute_gate_inplace( _ntk, g, values ) )
+    {
+      return;
+    }
+
+    _fanin_values.resize( _ntk.fanin_size( g ) );
+    _ntk.foreach_fanin( g, [&]( auto const& f, auto i ) {
+      _fanin_values[i] = values[_ntk.get_node( f )];
+    } );
+    result = _ntk.compute( g, _fanin_values.begin(), _fanin_values.end() );
+  }
+
+  void push_fanouts( node const& n )
+  {
+    for ( auto i = 0u; i < _num_fanouts[n]; ++i )
+    {
+      auto const& g = _fanouts[_first_fanout[n] + i];
+      if ( _queued[_position[g]] != _stamp )
+      {
+        _queued[_position[g]] = _stamp;
+        _queue.push( _position[g] );
+      }
+    }
+  }
+
+  /* event-driven simulation of flipping the stem `n` */
+  kitty::partial_truth_table simulate_stem( node const& n, fault_simulation_stats& st )
+  {
+    ++_stamp;
+    _queued.resize( _order.size(), 0u );
+
+    kitty::partial_truth_table care( _num_bits );
+    _faulty[n] = ~_tts[n];
+    _event[n] = _stamp;
+    push_fanouts( n );
+
+    uint32_t num_events{0u};
+    while ( !_queue.empty() )
+    {
+      /* outputs reached so far have their final values */
+      if ( _ps.max_events != 0u && num_events++ == _ps.max_events )
+      {
+        ++st.num_aborted_stems;
+        break;
+      }
+
+      auto const g = _order[_queue.top()];
+      _queue.pop();
+
+      auto& diff = _diff;
+      faulty_value( g, diff );
+      diff ^= _tts[g];
+      if ( kitty::is_const0( diff ) )
+      {
+        continue;
+      }
+
+      /* all remaining events pass through g, which has a known observability */
+      if ( _queue.empty() )
+      {
+        ++st.num_converged_stems;
+        care |= diff & _observability[g];
+        break;
+      }
+
+      if ( _num_po_refs[g] > 0u )
+      {
+        care |= diff;
+        continue;
+      }
+
+      /* patterns observed already need not be propagated further */
+      for ( auto i = 0u; i < diff.num_blocks(); ++i )
+      {
+        diff._bits[i] &= ~care._bits[i];
+      }
+      if ( kitty::is_const0( diff ) )
+      {
+        continue;
+      }
+      _faulty[g] = _tts[g];
+      _faulty[g] ^= diff;
+      _event[g] = _stamp;
+      push_fanouts( g );
+    }
+
+    /* drain remaining events */
+    while ( !_queue.empty() )
+    {
+      _queue.pop();
+    }
+    return care;
+  }
+
+private:
+  Ntk const& _ntk;
+  fault_simulation_params _ps;
+  fault_simulation_stats* _pst;
+  uint32_t _num_bits;
+
+  node_map<kitty::partial_truth_table, Ntk> _tts;
+  node_map<kitty::partial_truth_table, Ntk> _observability;
+  node_map<kitty::partial_truth_table, Ntk> _faulty;
+  node_map<uint32_t, Ntk> _event;
+  uint32_t _stamp{0u};
+
+  std::vector<node> _order;
+  node_map<uint32_t, Ntk> _position;
+  node_map<uint32_t, Ntk> _first_fanout;
+  node_map<uint32_t, Ntk> _num_fanouts;
+  node_map<uint32_t, Ntk> _num_po_refs;
+  std::vector<node> _fanouts;
+
+  std::priority_queue<uint32_t, std::vector<uint32_t>, std::greater<uint32_t>> _queue;
+  std::vector<uint32_t> _queued;
+  std::vector<kitty::partial_truth_table> _fanin_values;
+  kitty::partial_truth_table _diff;
+};
+
+} // namespace mockturtle
@@ -92,6 +92,9 @@ struct map_params
   /*! \brief Number of patterns for switching activity computation. */
   uint32_t switching_activity_patterns{ 2048u };
 
+  /*! \brief Number of threads for switching activity computation (0 for the number of hardware threads). */
+  uint32_t switching_activity_threads{ 1u };
+
   /*! \brief Exploit logic sharing in exact area optimization of graph mapping. */
   bool enable_logic_sharing{ false };
 
@@ -202,7 +205,7 @@ public:
         st( st ),
         node_match( ntk.size() ),
         matches(),
-        switch_activity( ps.eswp_rounds ? switching_activity( ntk, ps.switching_activity_patterns ) : std::vector<float>( 0 ) ),
+        switch_activity( ps.eswp_rounds ? switching_activity( ntk, ps.switching_activity_patterns, ps.switching_activity_threads ) : std::vector<float>( 0 ) ),
         cuts( fast_cut_enumeration<Ntk, CutSize, true, CutData>( ntk, ps.cut_enumeration_ps, &st.cut_enumeration_st ) )
   {
     std::tie( lib_inv_area, lib_inv_delay, lib_inv_id ) = library.get_inverter_info();
@@ -217,7 +220,7 @@ public:
         node_match( ntk.size() ),
         matches(),
         switch_activity( switch_activity ),
-        cuts( fast_cut_enumeration<Ntk, NInputs, true, CutData>( ntk, ps.cut_enumeration_ps, &st.cut_enumeration_st ) )
+        cuts( fast_cut_enumeration<Ntk, CutSize, true, CutData>( ntk, ps.cut_enumeration_ps, &st.cut_enumeration_st ) )
   {
     std::tie( lib_inv_area, lib_inv_delay, lib_inv_id ) = library.get_inverter_info();
     std::tie( lib_buf_area, lib_buf_delay, lib_buf_id ) = library.get_buffer_info();
@@ -1670,6 +1673,53 @@ binding_view<klut_network> map( Ntk const& ntk, tech_library<NInputs, Configurat
   return res;
 }
 
+/*! \brief Technology mapping with given switching activities.
+ *
+ * Same as `map`, but the exact switching power optimization uses the
+ * switching activities in `switch_activity`, indexed by `node_to_index`,
+ * instead of computing them by random simulation.  This avoids simulating
+ * the network again when it is mapped several times, e.g., with the
+ * activities of a `switching_activity_engine` that is kept up-to-date
+ * across edits.
+ *
+ * \param ntk Network
+ * \param library Technology library
+ * \param switch_activity Switching activity of each node
+ * \param ps Mapping params
+ * \param pst Mapping statistics
+ */
+template<class Ntk, unsigned CutSize = 5u, typename CutData = cut_enumeration_tech_map_cut, unsigned NInputs, classification_type Configuration>
+binding_view<klut_network> map( Ntk const& ntk, tech_library<NInputs, Configuration> const& library, std::vector<float> const& switch_activity, map_params const& ps = {}, map_stats* pst = nullptr )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+  static_assert( has_is_pi_v<Ntk>, "Ntk does not implement the is_pi method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+  static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+  static_assert( has_fanout_size_v<Ntk>, "Ntk does not implement the fanout_size method" );
+  assert( switch_activity.size() == ntk.size() );
+
+  map_stats st;
+  detail::tech_map_impl<Ntk, CutSize, CutData, NInputs, Configuration> p( ntk, library, switch_activity, ps, st );
+  auto res = p.run();
+
+  st.time_total = st.time_mapping + st.cut_enumeration_st.time_total;
+  if ( ps.verbose && !st.mapping_error )
+  {
+    st.report();
+  }
+
+  if ( pst )
+  {
+    *pst = st;
+  }
+  return res;
+}
+
 namespace detail
 {
 
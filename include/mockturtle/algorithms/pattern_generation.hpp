@@ -40,8 +40,10 @@
 #include <kitty/partial_truth_table.hpp>
 #include <mockturtle/algorithms/circuit_validator.hpp>
 #include <mockturtle/algorithms/dont_cares.hpp>
+#include <mockturtle/algorithms/fault_simulation.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <optional>
 #include <random>
 
 namespace mockturtle
@@ -74,6 +76,15 @@ struct pattern_generation_params
 
   /*! \brief Maximum number of clauses of the SAT solver. (incremental CNF construction) */
   uint32_t max_clauses{1000};
+
+  /*! \brief Skip the observability check of nodes whose stuck-at faults are detected by fault simulation. */
+  bool fault_dropping{true};
+
+  /*! \brief Compute the stuck-at fault coverage of the final patterns. */
+  bool fault_coverage{false};
+
+  /*! \brief Maximum number of gates evaluated per fanout stem in fault simulation (0 = no limit). */
+  uint32_t fault_sim_max_events{0};
 };
 
 struct pattern_generation_stats
@@ -90,6 +101,9 @@ struct pattern_generation_stats
   /*! \brief Time for ODC computation */
   stopwatch<>::duration time_odc{0};
 
+  /*! \brief Time for fault simulation. */
+  stopwatch<>::duration time_fault_sim{0};
+
   /*! \brief Number of constant nodes. */
   uint32_t num_constant{0};
 
@@ -104,6 +118,15 @@ struct pattern_generation_stats
 
   /*! \brief Number of unobservable nodes (node for which an observable pattern can not be found). */
   uint32_t unobservable_node{0};
+
+  /*! \brief Number of nodes dropped from the observability check because fault simulation detected both stuck-at faults. */
+  uint32_t num_dropped_nodes{0};
+
+  /*! \brief Number of stuck-at faults (only with `fault_coverage`). */
+  uint32_t num_faults{0};
+
+  /*! \brief Number of stuck-at faults detected by the final patterns (only with `fault_coverage`, a lower bound with `fault_sim_max_events`). */
+  uint32_t num_detected_faults{0};
 };
 
 namespace detail
@@ -171,6 +194,18 @@ public:
     {
       sim.randomize_dont_care_bits( ps.random_seed );
     }
+
+    if ( ps.fault_coverage )
+    {
+      call_with_stopwatch( st.time_fault_sim, [&]() {
+        fault_simulation_params fps;
+        fps.max_events = ps.fault_sim_max_events;
+        fault_simulator<Ntk> fsim( ntk, sim, fps );
+        fsim.run();
+        st.num_faults = fsim.num_faults();
+        st.num_detected_faults = fsim.num_detected_faults();
+      } );
+    }
   }
 
 private:
@@ -290,9 +325,27 @@ private:
 
     kitty::partial_truth_table zero = sim.compute_constant( false );
 
+    /* nodes observable with both values at the POs are observable in any TFO window */
+    std::optional<fault_simulator<Ntk>> fsim;
+    if ( ps.fault_dropping )
+    {
+      call_with_stopwatch( st.time_fault_sim, [&]() {
+        fault_simulation_params fps;
+        fps.max_events = ps.fault_sim_max_events;
+        fsim.emplace( ntk, sim, fps );
+        fsim->run();
+      } );
+    }
+
     ntk.foreach_gate( [&]( auto const& n, auto i ) {
       pbar( i, i, sim.num_bits() );
 
+      if ( fsim && fsim->is_detected( n, false ) && fsim->is_detected( n, true ) )
+      {
+        ++st.num_dropped_nodes;
+        return true; /* next gate */
+      }
+
       for ( auto& f : const_nodes )
       {
         if ( ntk.get_node( f ) == n )
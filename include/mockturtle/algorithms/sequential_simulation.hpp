@@ -0,0 +1,295 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file sequential_simulation.hpp
+  \brief Bit-parallel simulation of sequential networks over several cycles
+*/
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "simulation.hpp"
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for sequential_simulator.
+ *
+ * The default constructed parameters simulate 64 traces in parallel.
+ */
+struct sequential_simulation_params
+{
+  /*! \brief Number of 64-bit words, i.e., 64 traces each, simulated in parallel. */
+  uint32_t num_words{1u};
+
+  /*! \brief Seed for the initial values of registers without a reset value. */
+  uint64_t seed{1u};
+
+  /*! \brief Count the value changes of every node between two cycles. */
+  bool count_toggles{false};
+};
+
+/*! \brief Simulates many traces of a sequential network cycle by cycle.
+ *
+ * In every cycle, the primary inputs get their values from a pattern
+ * source (see `simulate_chunks`), which is called with `first_word`
+ * being `cycle * num_words`, and the register outputs get the values
+ * that the register inputs had in the previous cycle.  In the first cycle,
+ * register outputs are initialized with `latch_reset`: 0 and 1 are
+ * constant, all other values (e.g., nondeterministic or unknown
+ * initialization in `latch_info::init`) give random initial values.
+ * These are taken from the streams `num_pis() + i` of a
+ * `random_pattern_source` with seed `ps.seed`, where `i` is the index of
+ * the register.
+ *
+ * **Required network functions:**
+ * - `get_constant`
+ * - `constant_value`
+ * - `get_node`
+ * - `is_complemented`
+ * - `num_pis`
+ * - `foreach_pi`
+ * - `foreach_ro`
+ * - `foreach_ri`
+ * - `foreach_po`
+ * - `foreach_node`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `po_at`
+ * - `latch_reset`
+ * - `compute<kitty::partial_truth_table>`
+ */
+template<class Ntk>
+class sequential_simulator
+{
+public:
+  using node = typename Ntk::node;
+
+  explicit sequential_simulator( Ntk const& ntk, sequential_simulation_params const& ps = {} )
+      : _ntk( ntk ),
+        _ps( ps ),
+        _values( {node_map<kitty::partial_truth_table, Ntk>( ntk ), node_map<kitty::partial_truth_table, Ntk>( ntk )} ),
+        _toggles( ntk, 0u )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+    static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+    static_assert( has_num_pis_v<Ntk>, "Ntk does not implement the num_pis method" );
+    static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+    static_assert( has_foreach_ro_v<Ntk>, "Ntk does not implement the foreach_ro method" );
+    static_assert( has_foreach_ri_v<Ntk>, "Ntk does not implement the foreach_ri method" );
+    static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+    static_assert( has_po_at_v<Ntk>, "Ntk does not implement the po_at method" );
+    static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute method for kitty::partial_truth_table" );
+    assert( ps.num_words > 0u );
+
+    reset();
+  }
+
+  /*! \brief Sets the registers to their initial values and the cycle to 0. */
+  void reset()
+  {
+    _cycle = 0u;
+    _state.resize( _ntk.num_registers() );
+    random_pattern_source random_init( _ps.seed );
+    for ( auto i = 0u; i < _state.size(); ++i )
+    {
+      auto& tt = _state[i];
+      tt.resize( _ps.num_words * 64u );
+      switch ( _ntk.latch_reset( i ) )
+      {
+      case 0:
+        kitty::clear( tt );
+        break;
+      case 1:
+        kitty::clear( tt );
+        tt = ~tt;
+        break;
+      default:
+        /* streams after those of the PIs, such that a `random_pattern_source`
+         * with the same seed for the PIs gives independent values */
+        random_init( _ntk.num_pis() + i, 0u, tt );
+        break;
+      }
+    }
+    _toggles.reset( 0u );
+  }
+
+  /*! \brief Simulates one cycle with primary input values from `source`. */
+  template<class PatternSource>
+  void step( PatternSource const& source )
+  {
+    auto& values = current_values();
+    auto const num_bits = _ps.num_words * 64u;
+
+    const auto c0 = _ntk.get_node( _ntk.get_constant( false ) );
+    values[c0].resize( num_bits );
+    kitty::clear( values[c0] );
+    if ( _ntk.constant_value( c0 ) )
+    {
+      values[c0] = ~values[c0];
+    }
+    if ( const auto c1 = _ntk.get_node( _ntk.get_constant( true ) ); c1 != c0 )
+    {
+      values[c1] = ~values[c0];
+    }
+
+    _ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      values[n].resize( num_bits );
+      source( i, uint64_t( _cycle ) * _ps.num_words, values[n] );
+    } );
+    _ntk.foreach_ro( [&]( auto const& n, auto i ) {
+      values[n] = _state[i];
+    } );
+
+    _ntk.foreach_gate( [&]( auto const& n ) {
+      if ( detail::compute_gate_inplace( _ntk, n, values ) )
+      {
+        return;
+      }
+
+      _fanin_values.resize( _ntk.fanin_size( n ) );
+      _ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        _fanin_values[i] = values[f];
+      } );
+      values[n] = _ntk.compute( n, _fanin_values.begin(), _fanin_values.end() );
+    } );
+
+    _ntk.foreach_ri( [&]( auto const& f, auto i ) {
+      _state[i] = _ntk.is_complemented( f ) ? ~values[f] : values[f];
+    } );
+
+    if ( _ps.count_toggles && _cycle > 0u )
+    {
+      auto const& previous = previous_values();
+      _ntk.foreach_node( [&]( auto const& n ) {
+        if ( values[n].num_bits() != 0u )
+        {
+          _toggles[n] += kitty::count_ones( values[n] ^ previous[n] );
+        }
+      } );
+    }
+
+    ++_cycle;
+  }
+
+  /*! \brief Returns the number of simulated cycles since the last reset. */
+  uint32_t cycle() const
+  {
+    return _cycle;
+  }
+
+  /*! \brief Returns the value of `n` in the last simulated cycle. */
+  kitty::partial_truth_table const& value( node const& n ) const
+  {
+    return _values[( _cycle + 1u ) & index_mask()][n];
+  }
+
+  /*! \brief Returns the value of the `index`-th primary output in the last simulated cycle. */
+  kitty::partial_truth_table po_value( uint32_t index ) const
+  {
+    const auto f = _ntk.po_at( index );
+    return _ntk.is_complemented( f ) ? ~value( _ntk.get_node( f ) ) : value( _ntk.get_node( f ) );
+  }
+
+  /*! \brief Returns how often the value of `n` changed between two cycles in all traces.
+   *
+   * Only counted if `count_toggles` is set.
+   */
+  uint64_t toggles( node const& n ) const
+  {
+    return _toggles[n];
+  }
+
+private:
+  /* values of two consecutive cycles are only kept when counting toggles */
+  uint32_t index_mask() const
+  {
+    return _ps.count_toggles ? 1u : 0u;
+  }
+
+  node_map<kitty::partial_truth_table, Ntk>& current_values()
+  {
+    return _values[_cycle & index_mask()];
+  }
+
+  node_map<kitty::partial_truth_table, Ntk> const& previous_values() const
+  {
+    return _values[( _cycle + 1u ) & index_mask()];
+  }
+
+private:
+  Ntk const& _ntk;
+  sequential_simulation_params _ps;
+  uint32_t _cycle{0u};
+
+  std::array<node_map<kitty::partial_truth_table, Ntk>, 2u> _values;
+  std::vector<kitty::partial_truth_table> _state;
+  std::vector<kitty::partial_truth_table> _fanin_values;
+  node_map<uint64_t, Ntk> _toggles;
+};
+
+/*! \brief Simulates a sequential network for several cycles.
+ *
+ * Runs a `sequential_simulator` for `num_cycles` cycles and calls
+ * `fn( sim )` after each cycle, in which the values of the cycle can be
+ * read with `sim.value` and `sim.po_value`, e.g., for comparing outputs
+ * or accumulating toggle counts.
+ *
+ * \param ntk Sequential network
+ * \param num_cycles Number of cycles
+ * \param source Pattern source for the primary inputs, e.g., `random_pattern_source`
+ * \param fn Callback after every cycle
+ * \param ps Parameters
+ */
+template<class Ntk, class PatternSource, class Fn>
+void simulate_sequential( Ntk const& ntk, uint32_t num_cycles, PatternSource const& source, Fn&& fn, sequential_simulation_params const& ps = {} )
+{
+  sequential_simulator<Ntk> sim( ntk, ps );
+  for ( auto i = 0u; i < num_cycles; ++i )
+  {
+    sim.step( source );
+    fn( static_cast<sequential_simulator<Ntk> const&>( sim ) );
+  }
+}
+
+} // namespace mockturtle
@@ -34,13 +34,22 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 #include <fstream>
 #include <random>
 
 #include "../traits.hpp"
+#include "../utils/mapped_patterns.hpp"
 #include "../utils/node_map.hpp"
+#include "../utils/simd_kernels.hpp"
+#include "../utils/thread_barrier.hpp"
 
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
@@ -210,12 +219,28 @@ public:
    * The simulation pattern file should contain `num_pis` lines of the same length.
    * Each line is the simulation signature of a primary input, represented in hexadecimal.
    *
+   * Binary pattern files (see `write_binary_patterns`) are recognized and
+   * memory-mapped read-only instead of being parsed.  A binary pattern file
+   * that cannot be mapped, e.g., because its header is truncated or
+   * corrupt, throws `std::runtime_error`.
+   *
    * \param fielname Name of the simulation pattern file.
    * \param length Number of simulation patterns to keep. Should not be greater than 4 times 
    * the length of a line in the file. Setting this parameter to 0 means to keep all patterns in the file.
    */
   partial_simulator( const std::string& filename, uint32_t length = 0u )
   {
+    if ( is_binary_patterns_file( filename ) )
+    {
+      file = std::make_shared<mapped_patterns>( filename );
+      if ( !file->is_open() )
+      {
+        throw std::runtime_error( "cannot read binary pattern file " + filename + ": invalid or truncated header" );
+      }
+      num_patterns = length != 0u ? length : static_cast<uint32_t>( file->num_patterns() );
+      return;
+    }
+
     std::ifstream in( filename, std::ifstream::in );
     std::string line;
 
@@ -235,6 +260,23 @@ public:
     num_patterns = patterns[0].num_bits();
   }
 
+  /*! \brief Create a `partial_simulator` backed by a memory-mapped binary pattern file.
+   *
+   * The patterns are read from the mapped file when simulating primary
+   * inputs, without keeping a copy.  If the file is writable, patterns
+   * added with `add_pattern` are appended to the file; otherwise, the
+   * patterns are copied into memory on the first call to `add_pattern`.
+   *
+   * \param file Opened binary pattern file.
+   * \param length Number of simulation patterns to keep. Setting this parameter to 0 means to keep all patterns in the file.
+   */
+  partial_simulator( std::shared_ptr<mapped_patterns> const& file, uint32_t length = 0u )
+    : file( file ), num_patterns( length != 0u ? length : static_cast<uint32_t>( file->num_patterns() ) )
+  {
+    assert( file->is_open() );
+    assert( file->num_pis() > 0u );
+  }
+
   kitty::partial_truth_table compute_constant( bool value ) const
   {
     kitty::partial_truth_table zero( num_patterns );
@@ -243,6 +285,10 @@ public:
 
   kitty::partial_truth_table compute_pi( uint32_t index ) const
   {
+    if ( file )
+    {
+      return mapped_pattern( index );
+    }
     return patterns.at( index );
   }
 
@@ -263,6 +309,14 @@ public:
    */
   void add_pattern( std::vector<bool> const& pattern )
   {
+    if ( file && file->is_writable() && file->num_patterns() == num_patterns )
+    {
+      file->add_pattern( pattern );
+      ++num_patterns;
+      return;
+    }
+    materialize();
+
     assert( pattern.size() == patterns.size() );
 
     for ( auto i = 0u; i < pattern.size(); ++i )
@@ -278,11 +332,41 @@ public:
    */
   std::vector<kitty::partial_truth_table> get_patterns() const
   {
+    if ( file )
+    {
+      std::vector<kitty::partial_truth_table> mapped;
+      for ( auto i = 0u; i < file->num_pis(); ++i )
+      {
+        mapped.emplace_back( mapped_pattern( i ) );
+      }
+      return mapped;
+    }
     return patterns;
   }
 
+private:
+  kitty::partial_truth_table mapped_pattern( uint32_t index ) const
+  {
+    kitty::partial_truth_table tt( num_patterns );
+    const auto num_words = std::min<uint64_t>( tt.num_blocks(), ( file->num_patterns() + 63u ) >> 6 );
+    std::copy( file->words( index ), file->words( index ) + num_words, tt.begin() );
+    tt.mask_bits();
+    return tt;
+  }
+
+  /* copies the patterns of a mapped file into memory */
+  void materialize()
+  {
+    if ( file )
+    {
+      patterns = get_patterns();
+      file.reset();
+    }
+  }
+
 private:
   std::vector<kitty::partial_truth_table> patterns;
+  std::shared_ptr<mapped_patterns> file;
   uint32_t num_patterns;
 };
 
@@ -317,6 +401,7 @@ public:
   bit_packed_simulator( partial_simulator const& sim )
     : partial_simulator( sim ), packed_patterns( num_patterns )
   {
+    materialize();
     fill_cares( patterns.size() );
   }
 
@@ -329,6 +414,7 @@ public:
   bit_packed_simulator( const std::string& filename, uint32_t length = 0u )
     : partial_simulator( filename, length ), packed_patterns( num_patterns )
   {
+    materialize();
     fill_cares( patterns.size() );
   }
 
@@ -459,6 +545,379 @@ private:
   uint32_t packed_patterns;
 };
 
+namespace detail
+{
+
+/* checks whether `n` is an AND, XOR, MAJ, or XOR3 gate that can be simulated with the SIMD kernels */
+template<class Ntk>
+bool is_kernel_gate( Ntk const& ntk, typename Ntk::node const& n )
+{
+  if constexpr ( has_is_and_v<Ntk> && has_is_xor_v<Ntk> && has_is_maj_v<Ntk> && has_is_xor3_v<Ntk> && has_is_complemented_v<Ntk> )
+  {
+    const auto num_fanins = ntk.fanin_size( n );
+    return num_fanins == 2u ? ( ntk.is_and( n ) || ntk.is_xor( n ) ) : ( num_fanins == 3u && ( ntk.is_maj( n ) || ntk.is_xor3( n ) ) );
+  }
+  else
+  {
+    (void)ntk;
+    (void)n;
+    return false;
+  }
+}
+
+/* computes the words [first, first + num_words) of a kernel gate, whose truth table has the size of its fanins */
+template<class Ntk, class Container>
+void compute_gate_words( Ntk const& ntk, typename Ntk::node const& n, Container& node_to_value, std::size_t first, std::size_t num_words )
+{
+  if constexpr ( has_is_and_v<Ntk> && has_is_xor_v<Ntk> && has_is_maj_v<Ntk> && has_is_xor3_v<Ntk> && has_is_complemented_v<Ntk> )
+  {
+    std::array<uint64_t const*, 3u> words{};
+    std::array<uint64_t, 3u> masks{};
+    ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      words[i] = node_to_value[ntk.get_node( f )]._bits.data() + first;
+      masks[i] = ntk.is_complemented( f ) ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+    } );
+
+    auto const out = node_to_value[n]._bits.data() + first;
+    auto const& k = simd::get_kernels();
+    if ( ntk.fanin_size( n ) == 2u )
+    {
+      ( ntk.is_and( n ) ? k.and2 : k.xor2 )( out, words[0], masks[0], words[1], masks[1], num_words );
+    }
+    else
+    {
+      ( ntk.is_maj( n ) ? k.maj3 : k.xor3 )( out, words[0], masks[0], words[1], masks[1], words[2], masks[2], num_words );
+    }
+  }
+  else
+  {
+    (void)ntk;
+    (void)n;
+    (void)node_to_value;
+    (void)first;
+    (void)num_words;
+  }
+}
+
+/*! \brief Computes the partial truth table of an AND, XOR, MAJ, or XOR3 gate in place.
+ *
+ * The fanin values are read directly from `node_to_value` and the result is
+ * written into the (reused) truth table of `n` using the word-parallel
+ * kernels of the running CPU.  Returns false without computing anything if
+ * `n` is not one of these gates.
+ */
+template<class Ntk, class Container>
+bool compute_gate_inplace( Ntk const& ntk, typename Ntk::node const& n, Container& node_to_value )
+{
+  if ( !is_kernel_gate( ntk, n ) )
+  {
+    return false;
+  }
+
+  uint32_t num_bits{0};
+  ntk.foreach_fanin( n, [&]( auto const& f ) {
+    num_bits = node_to_value[ntk.get_node( f )].num_bits();
+    return false;
+  } );
+
+  auto& result = node_to_value[n];
+  result.resize( num_bits );
+  compute_gate_words( ntk, n, node_to_value, 0u, result.num_blocks() );
+  result.mask_bits();
+  return true;
+}
+
+} // namespace detail
+
+/*! \brief Parameters for simulate_chunks. */
+struct chunked_simulation_params
+{
+  /*! \brief Number of 64-bit pattern words simulated at once. */
+  uint32_t chunk_words{64u};
+};
+
+/*! \brief Generates random patterns for `simulate_chunks` on demand.
+ *
+ * Every pattern word is derived from the seed, the PI index, and the word
+ * position, such that the patterns do not depend on the chunk size and
+ * are never stored.
+ */
+class random_pattern_source
+{
+public:
+  explicit random_pattern_source( uint64_t seed = 1u )
+      : seed( seed )
+  {
+  }
+
+  void operator()( uint32_t pi_index, uint64_t first_word, kitty::partial_truth_table& tt ) const
+  {
+    for ( auto i = 0u; i < tt.num_blocks(); ++i )
+    {
+      /* splitmix64 */
+      uint64_t z = seed + ( ( uint64_t( pi_index ) << 40u ) ^ ( first_word + i ) ) * UINT64_C( 0x9e3779b97f4a7c15 );
+      z = ( z ^ ( z >> 30u ) ) * UINT64_C( 0xbf58476d1ce4e5b9 );
+      z = ( z ^ ( z >> 27u ) ) * UINT64_C( 0x94d049bb133111eb );
+      tt._bits[i] = z ^ ( z >> 31u );
+    }
+    tt.mask_bits();
+  }
+
+private:
+  uint64_t seed;
+};
+
+/*! \brief Reads the patterns for `simulate_chunks` from one truth table per PI. */
+class partial_truth_table_pattern_source
+{
+public:
+  explicit partial_truth_table_pattern_source( std::vector<kitty::partial_truth_table> const& patterns )
+      : patterns( patterns )
+  {
+  }
+
+  void operator()( uint32_t pi_index, uint64_t first_word, kitty::partial_truth_table& tt ) const
+  {
+    auto const& bits = patterns[pi_index]._bits;
+    std::copy( bits.begin() + first_word, bits.begin() + first_word + tt.num_blocks(), tt._bits.begin() );
+    tt.mask_bits();
+  }
+
+private:
+  std::vector<kitty::partial_truth_table> const& patterns;
+};
+
+/*! \brief Simulates a large number of patterns in chunks of pattern words.
+ *
+ * Instead of keeping the values of all nodes under all patterns, the
+ * patterns are simulated in chunks of `ps.chunk_words` 64-bit words, such
+ * that the memory is bounded by the number of nodes times the chunk size.
+ * The values of a chunk are passed to `fn`, which keeps what is needed
+ * from them, e.g., the values of the POs, signatures, or toggle counts;
+ * they are overwritten by the next chunk.
+ *
+ * The patterns are provided by `source`, which is called as
+ * `source( pi_index, first_word, tt )` and writes the words starting at
+ * `first_word` of the PI `pi_index` into `tt`, which already has the size
+ * of the chunk.  `fn` is called as `fn( node_to_value, first_pattern,
+ * num_patterns )` with a `node_map<kitty::partial_truth_table, Ntk> const&`
+ * whose truth tables have `num_patterns` bits.
+ *
+ * **Required network functions:**
+ * - `get_constant`
+ * - `constant_value`
+ * - `get_node`
+ * - `foreach_pi`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `compute<kitty::partial_truth_table>`
+ *
+ * \param ntk Network
+ * \param num_patterns Total number of patterns
+ * \param source Pattern source, e.g., `random_pattern_source`
+ * \param fn Callback for every chunk
+ * \param ps Parameters
+ */
+template<class Ntk, class PatternSource, class Fn>
+void simulate_chunks( Ntk const& ntk, uint64_t num_patterns, PatternSource const& source, Fn&& fn, chunked_simulation_params const& ps = {} )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+  static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute method for kitty::partial_truth_table" );
+  assert( ps.chunk_words > 0u );
+
+  node_map<kitty::partial_truth_table, Ntk> node_to_value( ntk );
+  std::vector<kitty::partial_truth_table> fanin_values;
+
+  const auto c0 = ntk.get_node( ntk.get_constant( false ) );
+  const auto c1 = ntk.get_node( ntk.get_constant( true ) );
+  const uint64_t chunk_bits = uint64_t( ps.chunk_words ) << 6u;
+
+  for ( uint64_t first = 0u; first < num_patterns; first += chunk_bits )
+  {
+    const auto num_bits = static_cast<uint32_t>( std::min( chunk_bits, num_patterns - first ) );
+
+    /* the truth tables keep their memory between chunks */
+    node_to_value[c0].resize( num_bits );
+    std::fill( node_to_value[c0]._bits.begin(), node_to_value[c0]._bits.end(), ntk.constant_value( c0 ) ? ~UINT64_C( 0 ) : UINT64_C( 0 ) );
+    node_to_value[c0].mask_bits();
+    if ( c1 != c0 )
+    {
+      node_to_value[c1] = ~node_to_value[c0];
+    }
+    ntk.foreach_pi( [&]( auto const& n, auto i ) {
+      node_to_value[n].resize( num_bits );
+      source( i, first >> 6u, node_to_value[n] );
+    } );
+
+    ntk.foreach_gate( [&]( auto const& n ) {
+      if ( detail::compute_gate_inplace( ntk, n, node_to_value ) )
+      {
+        return;
+      }
+
+      fanin_values.resize( ntk.fanin_size( n ) );
+      ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        fanin_values[i] = node_to_value[f];
+      } );
+      node_to_value[n] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+    } );
+
+    fn( static_cast<node_map<kitty::partial_truth_table, Ntk> const&>( node_to_value ), first, num_bits );
+  }
+}
+
+namespace detail
+{
+
+/* gives access to the simulation value of a node that is stored in a shared buffer */
+template<class SimulationType, class Ntk>
+struct buffer_values
+{
+  SimulationType& operator[]( typename Ntk::node const& n )
+  {
+    return buffers[slots[n]];
+  }
+
+  std::vector<SimulationType>& buffers;
+  node_map<uint32_t, Ntk>& slots;
+};
+
+/*! \brief Simulates the primary outputs and recycles the values of dead nodes.
+ *
+ * First computes for every node the position of the last gate (in the
+ * order of `foreach_gate`) that uses it, going backwards from the POs such
+ * that only uses by gates in the transitive fanin of the POs count.  Then,
+ * once this gate has been simulated, the value of the node is put into a
+ * free list and reused for a later gate.  Values of PO drivers are kept;
+ * dangling gates are not simulated.  The values are stored in `buffers`, whose size is the
+ * maximum number of values alive at the same time.
+ */
+template<class SimulationType, class Ntk, class Simulator>
+std::vector<SimulationType> simulate_outputs( Ntk const& ntk, Simulator const& sim, std::vector<SimulationType>& buffers )
+{
+  constexpr auto no_slot = std::numeric_limits<uint32_t>::max();
+  constexpr auto is_po = std::numeric_limits<uint32_t>::max();
+
+  /* last use by a live gate as position + 1, 0 if unused; going backwards,
+   * the first live gate that uses a node is its last use */
+  node_map<uint32_t, Ntk> last_use( ntk, 0u );
+  ntk.foreach_po( [&]( auto const& f ) {
+    last_use[f] = is_po;
+  } );
+
+  std::vector<typename Ntk::node> gates;
+  gates.reserve( ntk.size() );
+  ntk.foreach_gate( [&]( auto const& n ) {
+    gates.push_back( n );
+  } );
+  for ( auto i = static_cast<uint32_t>( gates.size() ); i-- > 0u; )
+  {
+    if ( last_use[gates[i]] == 0u )
+    {
+      continue;
+    }
+    ntk.foreach_fanin( gates[i], [&]( auto const& f ) {
+      if ( last_use[f] == 0u )
+      {
+        last_use[f] = i + 1u;
+      }
+    } );
+  }
+  uint32_t position{0};
+
+  node_map<uint32_t, Ntk> slots( ntk, no_slot );
+  std::vector<uint32_t> free_slots;
+  buffers.clear();
+
+  const auto allocate = [&]( auto const& n ) {
+    if ( free_slots.empty() )
+    {
+      slots[n] = static_cast<uint32_t>( buffers.size() );
+      buffers.emplace_back();
+    }
+    else
+    {
+      slots[n] = free_slots.back();
+      free_slots.pop_back();
+    }
+    return slots[n];
+  };
+
+  const auto c0 = ntk.get_node( ntk.get_constant( false ) );
+  const auto c1 = ntk.get_node( ntk.get_constant( true ) );
+  if ( last_use[c0] != 0u )
+  {
+    buffers[allocate( c0 )] = sim.compute_constant( ntk.constant_value( c0 ) );
+  }
+  if ( c1 != c0 && last_use[c1] != 0u )
+  {
+    buffers[allocate( c1 )] = sim.compute_constant( ntk.constant_value( c1 ) );
+  }
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    if ( last_use[n] != 0u )
+    {
+      buffers[allocate( n )] = sim.compute_pi( i );
+    }
+  } );
+
+  buffer_values<SimulationType, Ntk> values{buffers, slots};
+  std::vector<SimulationType> fanin_values;
+  ntk.foreach_gate( [&]( auto const& n ) {
+    ++position;
+    if ( last_use[n] == 0u )
+    {
+      return;
+    }
+
+    /* allocate before releasing the fanins, such that they are not overwritten */
+    const auto slot = allocate( n );
+    bool computed{false};
+    if constexpr ( std::is_same_v<SimulationType, kitty::partial_truth_table> )
+    {
+      computed = compute_gate_inplace( ntk, n, values );
+    }
+    if ( !computed )
+    {
+      fanin_values.resize( ntk.fanin_size( n ) );
+      ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+        fanin_values[i] = buffers[slots[f]];
+      } );
+      buffers[slot] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+    }
+
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      if ( last_use[f] == position && slots[f] != no_slot )
+      {
+        free_slots.push_back( slots[f] );
+        slots[f] = no_slot;
+      }
+    } );
+  } );
+
+  std::vector<SimulationType> po_values( ntk.num_pos() );
+  ntk.foreach_po( [&]( auto const& f, auto i ) {
+    if ( ntk.is_complemented( f ) )
+    {
+      po_values[i] = sim.compute_not( buffers[slots[f]] );
+    }
+    else
+    {
+      po_values[i] = buffers[slots[f]];
+    }
+  } );
+  return po_values;
+}
+
+} // namespace detail
+
 /*! \brief Simulates a network with a generic simulator.
  *
  * This is a generic simulation algorithm that can simulate arbitrary values.
@@ -516,6 +975,14 @@ node_map<SimulationType, Ntk> simulate_nodes( Ntk const& ntk, Simulator const& s
   } );
 
   ntk.foreach_gate( [&]( auto const& n ) {
+    if constexpr ( std::is_same_v<SimulationType, kitty::partial_truth_table> )
+    {
+      if ( detail::compute_gate_inplace( ntk, n, node_to_value ) )
+      {
+        return;
+      }
+    }
+
     std::vector<SimulationType> fanin_values( ntk.fanin_size( n ) );
     ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
       fanin_values[i] = node_to_value[f];
@@ -568,6 +1035,14 @@ void simulate_nodes_with_node_map( Ntk const& ntk, Container& node_to_value, Sim
   ntk.foreach_gate( [&]( auto const& n ) {
     if ( !node_to_value.has( n ) )
     {
+      if constexpr ( std::is_same_v<SimulationType, kitty::partial_truth_table> )
+      {
+        if ( compute_gate_inplace( ntk, n, node_to_value ) )
+        {
+          return;
+        }
+      }
+
       std::vector<SimulationType> fanin_values( ntk.fanin_size( n ) );
       ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
         fanin_values[i] = node_to_value[ntk.get_node( f )];
@@ -632,8 +1107,7 @@ template<class Ntk, class Simulator, class Container> void re_simulate_fanin_con
 template<class Ntk, class Simulator, class Container>
 void simulate_fanin_cone( Ntk const& ntk, typename Ntk::node const& n, Container& node_to_value, Simulator const& sim )
 {
-  std::vector<kitty::partial_truth_table> fanin_values( ntk.fanin_size( n ) );
-  ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+  ntk.foreach_fanin( n, [&]( auto const& f ) {
     if ( !node_to_value.has( ntk.get_node( f ) ) )
     {
       simulate_fanin_cone( ntk, ntk.get_node( f ), node_to_value, sim );
@@ -642,6 +1116,15 @@ void simulate_fanin_cone( Ntk const& ntk, typename Ntk::node const& n, Container
     {
       re_simulate_fanin_cone( ntk, ntk.get_node( f ), node_to_value, sim );
     }
+  } );
+
+  if ( compute_gate_inplace( ntk, n, node_to_value ) )
+  {
+    return;
+  }
+
+  std::vector<kitty::partial_truth_table> fanin_values( ntk.fanin_size( n ) );
+  ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
     fanin_values[i] = node_to_value[ntk.get_node( f )];
   } );
   node_to_value[n] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
@@ -766,6 +1249,215 @@ void simulate_nodes( Ntk const& ntk, Container& node_to_value, Simulator const&
   }
 }
 
+/*! \brief Parameters for simulate_nodes_parallel. */
+struct parallel_simulation_params
+{
+  /*! \brief Number of worker threads (0 for the number of hardware threads). */
+  uint32_t num_threads{0u};
+
+  /*! \brief Partition the 64-bit pattern words among the threads.
+   *
+   * Only applies to `kitty::partial_truth_table`.  Each thread simulates all
+   * nodes on its own range of words, without synchronization.  Otherwise,
+   * the nodes of each topological level are partitioned among the threads.
+   */
+  bool partition_words{true};
+};
+
+namespace detail
+{
+
+template<class Ntk>
+std::vector<std::vector<typename Ntk::node>> gates_by_level( Ntk const& ntk )
+{
+  std::vector<std::vector<typename Ntk::node>> levels;
+  node_map<uint32_t, Ntk> level( ntk, 0u );
+  ntk.foreach_gate( [&]( auto const& n ) {
+    uint32_t l{0};
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      l = std::max( l, level[ntk.get_node( f )] );
+    } );
+    level[n] = l + 1u;
+    if ( levels.size() < l + 1u )
+    {
+      levels.resize( l + 1u );
+    }
+    levels[l].push_back( n );
+  } );
+  return levels;
+}
+
+template<class SimulationType, class Ntk>
+void simulate_gate( Ntk const& ntk, typename Ntk::node const& n, node_map<SimulationType, Ntk>& node_to_value, std::vector<SimulationType>& fanin_values )
+{
+  if constexpr ( std::is_same_v<SimulationType, kitty::partial_truth_table> )
+  {
+    if ( compute_gate_inplace( ntk, n, node_to_value ) )
+    {
+      return;
+    }
+  }
+
+  fanin_values.resize( ntk.fanin_size( n ) );
+  ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+    fanin_values[i] = node_to_value[ntk.get_node( f )];
+  } );
+  node_to_value[n] = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+}
+
+template<class SimulationType, class Ntk>
+void simulate_levels_parallel( Ntk const& ntk, node_map<SimulationType, Ntk>& node_to_value, uint32_t num_threads )
+{
+  const auto levels = gates_by_level( ntk );
+  thread_barrier barrier( num_threads );
+
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < num_threads; ++t )
+  {
+    threads.emplace_back( [&, t]() {
+      std::vector<SimulationType> fanin_values;
+      for ( auto const& gates : levels )
+      {
+        /* contiguous chunks keep neighbouring nodes in one thread */
+        const auto chunk = ( gates.size() + num_threads - 1u ) / num_threads;
+        const auto end = std::min( gates.size(), ( t + 1u ) * chunk );
+        for ( auto i = t * chunk; i < end; ++i )
+        {
+          simulate_gate( ntk, gates[i], node_to_value, fanin_values );
+        }
+        barrier.wait();
+      }
+    } );
+  }
+
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+}
+
+template<class Ntk>
+void simulate_words_parallel( Ntk const& ntk, node_map<kitty::partial_truth_table, Ntk>& node_to_value, uint32_t num_bits, uint32_t num_threads )
+{
+  ntk.foreach_gate( [&]( auto const& n ) {
+    node_to_value[n] = kitty::partial_truth_table( num_bits );
+  } );
+
+  const auto num_words = ( num_bits + 63u ) / 64u;
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < num_threads; ++t )
+  {
+    const auto first = static_cast<std::size_t>( num_words ) * t / num_threads;
+    const auto last = static_cast<std::size_t>( num_words ) * ( t + 1u ) / num_threads;
+
+    threads.emplace_back( [&, first, last]() {
+      std::vector<kitty::partial_truth_table> fanin_values;
+      ntk.foreach_gate( [&]( auto const& n ) {
+        if ( is_kernel_gate( ntk, n ) )
+        {
+          compute_gate_words( ntk, n, node_to_value, first, last - first );
+          return;
+        }
+
+        /* other gates are computed on copies of the word range */
+        fanin_values.resize( ntk.fanin_size( n ) );
+        ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+          auto const& tt = node_to_value[ntk.get_node( f )];
+          fanin_values[i] = kitty::partial_truth_table( static_cast<uint32_t>( 64u * ( last - first ) ) );
+          std::copy( tt._bits.begin() + first, tt._bits.begin() + last, fanin_values[i]._bits.begin() );
+        } );
+        const auto tt = ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+        std::copy( tt._bits.begin(), tt._bits.end(), node_to_value[n]._bits.begin() + first );
+      } );
+    } );
+  }
+
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  /* complemented fanins leave ones in the unused bits of the last word */
+  ntk.foreach_gate( [&]( auto const& n ) {
+    node_to_value[n].mask_bits();
+  } );
+}
+
+} // namespace detail
+
+/*! \brief Simulates a network with several threads.
+ *
+ * Computes the same values as `simulate_nodes`.  The nodes are either
+ * simulated level by level, in which the gates of a level are distributed
+ * among the threads, or, for `kitty::partial_truth_table`, each thread
+ * simulates all gates on a disjoint range of 64-bit pattern words (see
+ * `parallel_simulation_params`).  All threads write into the same node map.
+ *
+ * `compute` must be safe to call concurrently for different nodes.
+ * Simulation with `bool` values is done sequentially.
+ *
+ * **Required network functions:**
+ * - `get_constant`
+ * - `constant_value`
+ * - `get_node`
+ * - `foreach_pi`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `compute<SimulationType>`
+ *
+ * \param ntk Network
+ * \param sim Simulator, which implements the simulator interface
+ * \param ps Parameters
+ */
+template<class SimulationType, class Ntk, class Simulator = default_simulator<SimulationType>>
+node_map<SimulationType, Ntk> simulate_nodes_parallel( Ntk const& ntk, Simulator const& sim = Simulator(), parallel_simulation_params const& ps = {} )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+  static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+  static_assert( has_compute_v<Ntk, SimulationType>, "Ntk does not implement the compute method for SimulationType" );
+
+  auto num_threads = ps.num_threads == 0u ? std::max( 1u, std::thread::hardware_concurrency() ) : ps.num_threads;
+
+  /* std::vector<bool> cannot be written concurrently */
+  if ( num_threads == 1u || std::is_same_v<SimulationType, bool> )
+  {
+    return simulate_nodes<SimulationType, Ntk, Simulator>( ntk, sim );
+  }
+
+  node_map<SimulationType, Ntk> node_to_value( ntk );
+
+  const auto c0 = ntk.get_node( ntk.get_constant( false ) );
+  node_to_value[c0] = sim.compute_constant( ntk.constant_value( c0 ) );
+  if ( const auto c1 = ntk.get_node( ntk.get_constant( true ) ); c1 != c0 )
+  {
+    node_to_value[c1] = sim.compute_constant( ntk.constant_value( c1 ) );
+  }
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    node_to_value[n] = sim.compute_pi( i );
+  } );
+
+  if constexpr ( std::is_same_v<SimulationType, kitty::partial_truth_table> )
+  {
+    if ( ps.partition_words )
+    {
+      const auto num_bits = node_to_value[c0].num_bits();
+      num_threads = std::max( 1u, std::min<uint32_t>( num_threads, ( num_bits + 63u ) / 64u ) );
+      detail::simulate_words_parallel( ntk, node_to_value, num_bits, num_threads );
+      return node_to_value;
+    }
+  }
+
+  detail::simulate_levels_parallel( ntk, node_to_value, num_threads );
+  return node_to_value;
+}
+
 /*! \brief Simulates a network with a generic simulator.
  *
  * This is a generic simulation algorithm that can simulate arbitrary values.
@@ -784,6 +1476,11 @@ void simulate_nodes( Ntk const& ntk, Container& node_to_value, Simulator const&
  * position) to it's simulation value (taking possible complemented attributes
  * into account).
  *
+ * For `kitty::dynamic_truth_table` and `kitty::partial_truth_table`, the
+ * value of a node is released as soon as its last fanout has been
+ * simulated and its memory is reused for later nodes, such that only the
+ * values alive at the same time are stored.
+ *
  * **Required network functions:**
  * - `foreach_po`
  * - `is_complemented`
@@ -800,6 +1497,12 @@ std::vector<SimulationType> simulate( Ntk const& ntk, Simulator const& sim = Sim
   static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented function" );
   static_assert( has_compute_v<Ntk, SimulationType>, "Ntk does not implement the compute function for SimulationType" );
 
+  if constexpr ( std::is_same_v<SimulationType, kitty::dynamic_truth_table> || std::is_same_v<SimulationType, kitty::partial_truth_table> )
+  {
+    std::vector<SimulationType> buffers;
+    return detail::simulate_outputs<SimulationType>( ntk, sim, buffers );
+  }
+
   const auto node_to_value = simulate_nodes<SimulationType, Ntk, Simulator>( ntk, sim );
 
   std::vector<SimulationType> po_values( ntk.num_pos() );
@@ -0,0 +1,419 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file simulation_program.hpp
+  \brief Compiles a network into a straight-line simulation program
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/node_map.hpp"
+#include "../utils/simd_kernels.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Operation of an instruction in a `simulation_program`. */
+enum class simulation_opcode : uint32_t
+{
+  and2,
+  xor2,
+  maj3,
+  xor3
+};
+
+/*! \brief Instruction of a `simulation_program`.
+ *
+ * Operands are literals `2 * slot + complement`; the result is written to
+ * slot `output`.
+ */
+struct simulation_instruction
+{
+  simulation_opcode opcode;
+  uint32_t output;
+  std::array<uint32_t, 3u> operands;
+};
+
+/*! \brief Straight-line program that simulates a network on 64-bit words.
+ *
+ * The program is created with `compile_simulation` and consists of one
+ * instruction per gate in topological order.  Every value lives in a slot
+ * of `num_words` words; slots of values that are no longer used are
+ * reused for later gates.  Slot 0 holds constant 0 and slots 1 to
+ * `num_pis()` hold the primary inputs.
+ *
+ * Running the program does not access the network anymore, which avoids
+ * the traversal and the `compute` dispatch when the same network is
+ * simulated many times.  The program is not thread-safe, since it owns
+ * the buffer for the slots.
+ */
+class simulation_program
+{
+public:
+  simulation_program() = default;
+
+  simulation_program( uint32_t num_pis, uint32_t num_slots, std::vector<simulation_instruction> instructions, std::vector<uint32_t> outputs )
+      : _num_pis( num_pis ),
+        _num_slots( num_slots ),
+        _instructions( std::move( instructions ) ),
+        _outputs( std::move( outputs ) )
+  {
+  }
+
+  uint32_t num_pis() const
+  {
+    return _num_pis;
+  }
+
+  uint32_t num_pos() const
+  {
+    return static_cast<uint32_t>( _outputs.size() );
+  }
+
+  uint32_t num_slots() const
+  {
+    return _num_slots;
+  }
+
+  std::vector<simulation_instruction> const& instructions() const
+  {
+    return _instructions;
+  }
+
+  /*! \brief Output literals `2 * slot + complement`, one for each primary output. */
+  std::vector<uint32_t> const& outputs() const
+  {
+    return _outputs;
+  }
+
+  /*! \brief Runs the program on a block of words.
+   *
+   * `inputs` contains `num_words` words for each primary input, one input
+   * after the other; `outputs` receives `num_words` words for each primary
+   * output in the same layout.
+   */
+  void run( uint64_t const* inputs, uint64_t* outputs, uint32_t num_words )
+  {
+    _values.resize( std::size_t( _num_slots ) * num_words );
+    auto const values = _values.data();
+
+    std::fill( values, values + num_words, UINT64_C( 0 ) );
+    std::copy( inputs, inputs + std::size_t( _num_pis ) * num_words, values + num_words );
+
+    if ( num_words == 1u )
+    {
+      run_word( values );
+    }
+    else
+    {
+      run_words( values, num_words );
+    }
+
+    for ( auto const& lit : _outputs )
+    {
+      auto const mask = literal_mask( lit );
+      auto const first = values + std::size_t( lit >> 1u ) * num_words;
+      std::transform( first, first + num_words, outputs, [mask]( auto w ) { return w ^ mask; } );
+      outputs += num_words;
+    }
+  }
+
+  /*! \brief Simulates the primary outputs with a simulator.
+   *
+   * Same as `simulate<SimulationType>( ntk, sim )` for the compiled
+   * network, for `bool` and truth table types whose words can be iterated.
+   */
+  template<class SimulationType, class Simulator>
+  std::vector<SimulationType> simulate( Simulator const& sim )
+  {
+    std::vector<SimulationType> po_values( num_pos() );
+
+    if constexpr ( std::is_same_v<SimulationType, bool> )
+    {
+      _inputs.resize( _num_pis );
+      for ( auto i = 0u; i < _num_pis; ++i )
+      {
+        _inputs[i] = sim.compute_pi( i ) ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+      }
+      _results.resize( num_pos() );
+      run( _inputs.data(), _results.data(), 1u );
+      for ( auto i = 0u; i < num_pos(); ++i )
+      {
+        po_values[i] = _results[i] & 1u;
+      }
+    }
+    else
+    {
+      auto const zero = sim.compute_constant( false );
+      auto const num_words = static_cast<uint32_t>( std::distance( zero.begin(), zero.end() ) );
+
+      _inputs.resize( std::size_t( _num_pis ) * num_words );
+      for ( auto i = 0u; i < _num_pis; ++i )
+      {
+        auto const tt = sim.compute_pi( i );
+        std::copy( tt.begin(), tt.end(), _inputs.begin() + std::size_t( i ) * num_words );
+      }
+      _results.resize( std::size_t( num_pos() ) * num_words );
+      run( _inputs.data(), _results.data(), num_words );
+
+      for ( auto i = 0u; i < num_pos(); ++i )
+      {
+        po_values[i] = zero;
+        auto const first = _results.begin() + std::size_t( i ) * num_words;
+        std::copy( first, first + num_words, po_values[i].begin() );
+        po_values[i].mask_bits();
+      }
+    }
+
+    return po_values;
+  }
+
+private:
+  static uint64_t literal_mask( uint32_t lit )
+  {
+    return ( lit & 1u ) ? ~UINT64_C( 0 ) : UINT64_C( 0 );
+  }
+
+  /* one word per slot: the operations are inlined */
+  void run_word( uint64_t* values ) const
+  {
+    const auto operand = [values]( uint32_t lit ) { return values[lit >> 1u] ^ literal_mask( lit ); };
+
+    for ( auto const& ins : _instructions )
+    {
+      auto const a = operand( ins.operands[0] );
+      auto const b = operand( ins.operands[1] );
+      switch ( ins.opcode )
+      {
+      case simulation_opcode::and2:
+        values[ins.output] = a & b;
+        break;
+      case simulation_opcode::xor2:
+        values[ins.output] = a ^ b;
+        break;
+      case simulation_opcode::maj3:
+      {
+        auto const c = operand( ins.operands[2] );
+        values[ins.output] = ( a & b ) | ( a & c ) | ( b & c );
+      }
+      break;
+      case simulation_opcode::xor3:
+        values[ins.output] = a ^ b ^ operand( ins.operands[2] );
+        break;
+      }
+    }
+  }
+
+  /* several words per slot: the word-parallel kernels are called */
+  void run_words( uint64_t* values, uint32_t num_words ) const
+  {
+    auto const& k = simd::get_kernels();
+    const auto slot = [&]( uint32_t lit ) { return values + std::size_t( lit >> 1u ) * num_words; };
+
+    for ( auto const& ins : _instructions )
+    {
+      auto const out = values + std::size_t( ins.output ) * num_words;
+      auto const& ops = ins.operands;
+      switch ( ins.opcode )
+      {
+      case simulation_opcode::and2:
+        k.and2( out, slot( ops[0] ), literal_mask( ops[0] ), slot( ops[1] ), literal_mask( ops[1] ), num_words );
+        break;
+      case simulation_opcode::xor2:
+        k.xor2( out, slot( ops[0] ), literal_mask( ops[0] ), slot( ops[1] ), literal_mask( ops[1] ), num_words );
+        break;
+      case simulation_opcode::maj3:
+        k.maj3( out, slot( ops[0] ), literal_mask( ops[0] ), slot( ops[1] ), literal_mask( ops[1] ), slot( ops[2] ), literal_mask( ops[2] ), num_words );
+        break;
+      case simulation_opcode::xor3:
+        k.xor3( out, slot( ops[0] ), literal_mask( ops[0] ), slot( ops[1] ), literal_mask( ops[1] ), slot( ops[2] ), literal_mask( ops[2] ), num_words );
+        break;
+      }
+    }
+  }
+
+private:
+  uint32_t _num_pis{0};
+  uint32_t _num_slots{1};
+  std::vector<simulation_instruction> _instructions;
+  std::vector<uint32_t> _outputs;
+
+  std::vector<uint64_t> _values;
+  std::vector<uint64_t> _inputs;
+  std::vector<uint64_t> _results;
+};
+
+/*! \brief Compiles a network into a simulation program.
+ *
+ * Every gate must be an AND, XOR, MAJ, or XOR3 gate, i.e., the network is
+ * an AIG, XAG, MIG, or XMG.  Dangling gates are not compiled, and the slot
+ * of a value is reused once its last fanout has been compiled.
+ *
+ * Buffered networks are rejected at compile time, since `foreach_gate`
+ * skips their buffers.  The function throws `std::invalid_argument` if a
+ * gate has another function or if a fanin is neither a constant, a PI,
+ * nor a gate visited by `foreach_gate` (e.g., a register output).
+ *
+ * **Required network functions:**
+ * - `get_node`
+ * - `is_complemented`
+ * - `is_constant`
+ * - `foreach_pi`
+ * - `foreach_po`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `is_and`, `is_xor`, `is_maj`, `is_xor3`
+ *
+ * \param ntk Network
+ */
+template<class Ntk>
+simulation_program compile_simulation( Ntk const& ntk )
+{
+  static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+  static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+  static_assert( has_is_complemented_v<Ntk>, "Ntk does not implement the is_complemented method" );
+  static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+  static_assert( has_foreach_pi_v<Ntk>, "Ntk does not implement the foreach_pi method" );
+  static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
+  static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+  static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+  static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+  static_assert( has_is_and_v<Ntk>, "Ntk does not implement the is_and method" );
+  static_assert( has_is_xor_v<Ntk>, "Ntk does not implement the is_xor method" );
+  static_assert( has_is_maj_v<Ntk>, "Ntk does not implement the is_maj method" );
+  static_assert( has_is_xor3_v<Ntk>, "Ntk does not implement the is_xor3 method" );
+  static_assert( !is_buffered_network_type_v<Ntk>, "Ntk is a buffered network, whose buffers are not visited by foreach_gate" );
+
+  constexpr auto no_slot = std::numeric_limits<uint32_t>::max();
+  constexpr auto is_po = std::numeric_limits<uint32_t>::max();
+
+  /* last use as position + 1, 0 if unused */
+  node_map<uint32_t, Ntk> last_use( ntk, 0u );
+  uint32_t position{0};
+  ntk.foreach_gate( [&]( auto const& n ) {
+    ++position;
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      last_use[f] = position;
+    } );
+  } );
+  ntk.foreach_po( [&]( auto const& f ) {
+    last_use[f] = is_po;
+  } );
+
+  node_map<uint32_t, Ntk> slots( ntk, no_slot );
+  std::vector<uint32_t> free_slots;
+  uint32_t num_slots{1u};
+  uint32_t num_pis{0u};
+  ntk.foreach_pi( [&]( auto const& n ) {
+    slots[n] = num_slots++;
+    ++num_pis;
+  } );
+
+  const auto literal = [&]( auto const& f ) {
+    const auto slot = ntk.is_constant( ntk.get_node( f ) ) ? 0u : slots[f];
+    if ( slot == no_slot )
+    {
+      throw std::invalid_argument( "compile_simulation: fanin is neither a constant, a PI, nor a gate" );
+    }
+    return ( slot << 1u ) | ( ntk.is_complemented( f ) ? 1u : 0u );
+  };
+
+  std::vector<simulation_instruction> instructions;
+  position = 0u;
+  ntk.foreach_gate( [&]( auto const& n ) {
+    ++position;
+    if ( last_use[n] == 0u )
+    {
+      return;
+    }
+
+    simulation_instruction ins{};
+    const auto fanin_size = ntk.fanin_size( n );
+    if ( fanin_size == 2u && ntk.is_and( n ) )
+    {
+      ins.opcode = simulation_opcode::and2;
+    }
+    else if ( fanin_size == 2u && ntk.is_xor( n ) )
+    {
+      ins.opcode = simulation_opcode::xor2;
+    }
+    else if ( fanin_size == 3u && ntk.is_maj( n ) )
+    {
+      ins.opcode = simulation_opcode::maj3;
+    }
+    else if ( fanin_size == 3u && ntk.is_xor3( n ) )
+    {
+      ins.opcode = simulation_opcode::xor3;
+    }
+    else
+    {
+      throw std::invalid_argument( "compile_simulation: gate is not an AND, XOR, MAJ, or XOR3 gate" );
+    }
+    ntk.foreach_fanin( n, [&]( auto const& f, auto i ) {
+      ins.operands[i] = literal( f );
+    } );
+
+    /* operands are read before the output is written, so a released slot can be reused right away */
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      if ( last_use[f] == position && slots[f] != no_slot && !ntk.is_constant( ntk.get_node( f ) ) )
+      {
+        free_slots.push_back( slots[f] );
+        slots[f] = no_slot;
+      }
+    } );
+
+    if ( free_slots.empty() )
+    {
+      slots[n] = num_slots++;
+    }
+    else
+    {
+      slots[n] = free_slots.back();
+      free_slots.pop_back();
+    }
+    ins.output = slots[n];
+    instructions.push_back( ins );
+  } );
+
+  std::vector<uint32_t> outputs;
+  ntk.foreach_po( [&]( auto const& f ) {
+    outputs.push_back( literal( f ) );
+  } );
+
+  return simulation_program( num_pis, num_slots, std::move( instructions ), std::move( outputs ) );
+}
+
+} // namespace mockturtle
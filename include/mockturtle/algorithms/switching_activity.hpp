@@ -0,0 +1,396 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file switching_activity.hpp
+  \brief Incremental switching activity estimation
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "../traits.hpp"
+#include "../utils/fanout_tracker.hpp"
+#include "../utils/node_map.hpp"
+#include "simulation.hpp"
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+namespace mockturtle
+{
+
+/*! \brief Parameters for switching_activity_engine. */
+struct switching_activity_params
+{
+  /*! \brief Number of random patterns. */
+  uint32_t num_patterns{2048u};
+
+  /*! \brief Number of worker threads (0 for the number of hardware threads). */
+  uint32_t num_threads{1u};
+
+  /*! \brief Number of 64-bit pattern words simulated at once by each thread. */
+  uint32_t chunk_words{64u};
+
+  /*! \brief Seed for the random patterns. */
+  uint64_t seed{1u};
+};
+
+/*! \brief Estimates the switching activity of all nodes by random simulation.
+ *
+ * The switching activity of a node is `2 p (1 - p)`, in which `p` is the
+ * fraction of random patterns under which the node is 1.  Only the number
+ * of ones is stored per node; the patterns are simulated in chunks of
+ * `chunk_words` words, which are distributed among the threads, and are
+ * generated on demand by a `random_pattern_source`.  Every CI gets its own
+ * stream in the order of `foreach_ci`, i.e., register outputs are treated
+ * as independent random inputs.
+ *
+ * An edit changes the signal probabilities of the edited node and of its
+ * transitive fanout, which are counted again when activities are queried.
+ * Since only the number of ones is kept per node, this also simulates
+ * their whole transitive fanin, i.e., an edit costs the simulation of the
+ * transitive fanin of its transitive fanout.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_constant`
+ * - `constant_value`
+ * - `get_node`
+ * - `node_to_index`
+ * - `index_to_node`
+ * - `is_constant`
+ * - `is_ci`
+ * - `foreach_ci`
+ * - `foreach_node`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `fanin_size`
+ * - `compute<kitty::partial_truth_table>`
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      switching_activity_engine sw{aig};
+
+      auto const activity = sw.activity( n );
+      aig.substitute_node( m, f );   // marks the fanout of m as out of date
+      map( aig, lib, sw.activities(), ps );
+   \endverbatim
+ */
+template<class Ntk>
+class switching_activity_engine
+{
+public:
+  using node = typename Ntk::node;
+
+  explicit switching_activity_engine( Ntk const& ntk, switching_activity_params const& ps = {} )
+      : _ntk( ntk ),
+        _ps( ps ),
+        _ones( ntk, 0u ),
+        _dirty( ntk, 0u ),
+        _visited( ntk, 0u )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+    static_assert( has_constant_value_v<Ntk>, "Ntk does not implement the constant_value method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+    static_assert( has_is_constant_v<Ntk>, "Ntk does not implement the is_constant method" );
+    static_assert( has_is_ci_v<Ntk>, "Ntk does not implement the is_ci method" );
+    static_assert( has_foreach_ci_v<Ntk>, "Ntk does not implement the foreach_ci method" );
+    static_assert( has_foreach_node_v<Ntk>, "Ntk does not implement the foreach_node method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_fanin_size_v<Ntk>, "Ntk does not implement the fanin_size method" );
+    static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute method for kitty::partial_truth_table" );
+    assert( ps.chunk_words > 0u );
+
+    track_events();
+    ntk.foreach_node( [&]( auto const& n ) {
+      mark_dirty( n );
+    } );
+  }
+
+  switching_activity_engine( switching_activity_engine<Ntk> const& ) = delete;
+  switching_activity_engine<Ntk>& operator=( switching_activity_engine<Ntk> const& ) = delete;
+
+  /*! \brief Returns the switching activity of `n`. */
+  float activity( node const& n ) const
+  {
+    update();
+
+    float const ones = static_cast<float>( _ones[n] );
+    float const size = static_cast<float>( _ps.num_patterns );
+    return 2.0f * ones / size * ( size - ones ) / size;
+  }
+
+  /*! \brief Returns the switching activities of all nodes, indexed by `node_to_index`. */
+  std::vector<float> activities() const
+  {
+    update();
+
+    std::vector<float> sw_map( _ntk.size(), 0.0f );
+    _ntk.foreach_node( [&]( auto const& n ) {
+      sw_map[_ntk.node_to_index( n )] = activity( n );
+    } );
+    return sw_map;
+  }
+
+  /*! \brief Returns under how many patterns `n` is 1. */
+  uint64_t num_ones( node const& n ) const
+  {
+    update();
+    return _ones[n];
+  }
+
+  /*! \brief Returns the number of nodes that are out of date. */
+  uint32_t num_dirty() const
+  {
+    return static_cast<uint32_t>( _pending.size() );
+  }
+
+  /*! \brief Simulates the nodes that are out of date together with their transitive fanin. */
+  void update() const
+  {
+    if ( _pending.empty() )
+    {
+      return;
+    }
+
+    collect_cone();
+    count_ones();
+
+    for ( auto const& n : _pending )
+    {
+      _dirty[n] = 0u;
+    }
+    _pending.clear();
+  }
+
+private:
+  /* collects the out-of-date nodes and their transitive fanin in topological order */
+  void collect_cone() const
+  {
+    ++_trav_id;
+    _order.clear();
+    for ( auto const& root : _pending )
+    {
+      if ( _visited[root] == _trav_id || _ntk.is_constant( root ) )
+      {
+        continue;
+      }
+      if constexpr ( has_is_dead_v<Ntk> )
+      {
+        if ( _ntk.is_dead( root ) )
+        {
+          continue;
+        }
+      }
+
+      /* iterative DFS, a node is appended when all its fanins are */
+      _stack.emplace_back( root, false );
+      while ( !_stack.empty() )
+      {
+        auto const [n, expanded] = _stack.back();
+        _stack.pop_back();
+        if ( expanded )
+        {
+          _order.push_back( n );
+          continue;
+        }
+        if ( _visited[n] == _trav_id || _ntk.is_constant( n ) )
+        {
+          continue;
+        }
+        _visited[n] = _trav_id;
+        _stack.emplace_back( n, true );
+        if ( !_ntk.is_ci( n ) )
+        {
+          _ntk.foreach_fanin( n, [&]( auto const& f ) {
+            if ( _visited[_ntk.get_node( f )] != _trav_id )
+            {
+              _stack.emplace_back( _ntk.get_node( f ), false );
+            }
+          } );
+        }
+      }
+    }
+  }
+
+  /* simulates the collected nodes and counts the ones of the out-of-date ones */
+  void count_ones() const
+  {
+    std::vector<uint32_t> ci_index( _ntk.size(), 0u );
+    _ntk.foreach_ci( [&]( auto const& n, auto i ) {
+      ci_index[_ntk.node_to_index( n )] = i;
+    } );
+
+    for ( auto const& n : _order )
+    {
+      if ( _dirty[n] )
+      {
+        _ones[n] = 0u;
+      }
+    }
+
+    auto const num_words = ( uint64_t( _ps.num_patterns ) + 63u ) / 64u;
+    auto const num_threads = std::max<uint64_t>( 1u, std::min<uint64_t>( _ps.num_threads == 0u ? std::thread::hardware_concurrency() : _ps.num_threads, num_words ) );
+
+    std::vector<std::vector<uint64_t>> counts( num_threads );
+    auto const simulate_words = [&]( uint32_t t ) {
+      auto const first = num_words * t / num_threads;
+      auto const last = num_words * ( t + 1u ) / num_threads;
+      random_pattern_source const source( _ps.seed );
+      node_map<kitty::partial_truth_table, Ntk> node_to_value( _ntk );
+      std::vector<kitty::partial_truth_table> fanin_values;
+
+      auto& count = counts[t];
+      count.assign( _order.size(), 0u );
+
+      for ( auto word = first; word < last; word += _ps.chunk_words )
+      {
+        auto const num_bits = static_cast<uint32_t>( std::min<uint64_t>( std::min<uint64_t>( last, word + _ps.chunk_words ) * 64u, _ps.num_patterns ) - word * 64u );
+
+        /* constants are not in the cone, but may be fanins */
+        for ( auto const c : {_ntk.get_node( _ntk.get_constant( false ) ), _ntk.get_node( _ntk.get_constant( true ) )} )
+        {
+          node_to_value[c].resize( num_bits );
+          kitty::clear( node_to_value[c] );
+          if ( _ntk.constant_value( c ) )
+          {
+            node_to_value[c] = ~node_to_value[c];
+          }
+        }
+
+        for ( auto i = 0u; i < _order.size(); ++i )
+        {
+          auto const& n = _order[i];
+          if ( _ntk.is_ci( n ) )
+          {
+            node_to_value[n].resize( num_bits );
+            source( ci_index[_ntk.node_to_index( n )], word, node_to_value[n] );
+          }
+          else if ( !detail::compute_gate_inplace( _ntk, n, node_to_value ) )
+          {
+            fanin_values.resize( _ntk.fanin_size( n ) );
+            _ntk.foreach_fanin( n, [&]( auto const& f, auto j ) {
+              fanin_values[j] = node_to_value[f];
+            } );
+            node_to_value[n] = _ntk.compute( n, fanin_values.begin(), fanin_values.end() );
+          }
+
+          if ( _dirty[n] )
+          {
+            count[i] += kitty::count_ones( node_to_value[n] );
+          }
+        }
+      }
+    };
+
+    if ( num_threads == 1u )
+    {
+      simulate_words( 0u );
+    }
+    else
+    {
+      std::vector<std::thread> threads;
+      for ( auto t = 0u; t < num_threads; ++t )
+      {
+        threads.emplace_back( simulate_words, t );
+      }
+      for ( auto& thread : threads )
+      {
+        thread.join();
+      }
+    }
+
+    for ( auto const& count : counts )
+    {
+      for ( auto i = 0u; i < _order.size(); ++i )
+      {
+        _ones[_order[i]] += count[i];
+      }
+    }
+  }
+
+  /* returns whether `n` has been marked as out of date now */
+  bool mark_dirty( node const& n )
+  {
+    if ( _dirty[n] )
+    {
+      return false;
+    }
+    _dirty[n] = 1u;
+    _pending.push_back( n );
+    return true;
+  }
+
+  void track_events()
+  {
+    _tracker.build( _ntk );
+    _tracker.track(
+        _ntk,
+        [this]( auto const& n ) {
+          _ones.resize();
+          _dirty.resize( 0u );
+          _visited.resize( 0u );
+          mark_dirty( n );
+        },
+        [this]( auto const& n ) {
+          /* if n is out of date, so is its fanout */
+          _tracker.mark_tfo( n, [this]( auto const& m ) { return mark_dirty( m ); } );
+        },
+        [this]( auto const& n ) {
+          _ones[n] = 0u;
+        } );
+  }
+
+private:
+  Ntk const& _ntk;
+  switching_activity_params _ps;
+
+  mutable node_map<uint64_t, Ntk> _ones;
+  mutable node_map<uint8_t, Ntk> _dirty;
+  mutable std::vector<node> _pending;
+  detail::fanout_tracker<Ntk> _tracker;
+
+  mutable node_map<uint32_t, Ntk> _visited;
+  mutable uint32_t _trav_id{0u};
+  mutable std::vector<node> _order;
+  mutable std::vector<std::pair<node, bool>> _stack;
+};
+
+} // namespace mockturtle
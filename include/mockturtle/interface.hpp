@@ -339,11 +339,13 @@ public:
   /*! \brief Perform multiple node-signal replacements in a network.
    *
    * This method replaces all occurrences of a node with a signal for
-   * all pairs (node, signal) in the substitution list.
+   * all pairs (node, signal) in the substitution list.  Nodes that become
+   * redundant during the replacement are substituted as well.
    *
    * \brief substitutions A list of (node, signal) replacement pairs
+   * \return Number of nodes whose fanins have been replaced
    */
-  void substitute_nodes( std::list<std::pair<node, signal>> substitutions );
+  uint32_t substitute_nodes( std::list<std::pair<node, signal>> const& substitutions );
 
   /*! \brief Replaces a child node by a new signal in a node.
    *
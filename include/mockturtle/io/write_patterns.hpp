@@ -33,15 +33,18 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <kitty/print.hpp>
 
 #include "../algorithms/simulation.hpp"
+#include "../utils/mapped_patterns.hpp"
 
 namespace mockturtle
 {
@@ -84,4 +87,47 @@ void write_patterns( Simulator const& sim, std::string const& filename )
   os.close();
 }
 
+/*! \brief Writes simulation patterns in binary format
+ *
+ * The output is a binary pattern file (see `binary_patterns_header`),
+ * which can be memory-mapped by `partial_simulator` instead of being
+ * parsed.  The rows are word-aligned and leave room for appending up to
+ * `capacity` patterns in total.
+ *
+ * \param sim The `partial_simulator` or `bit_packed_simulator` object containing simulation patterns
+ * \param out Output stream (opened in binary mode)
+ * \param capacity Minimum number of patterns that fit in the file
+ */
+template<class Simulator>
+void write_binary_patterns( Simulator const& sim, std::ostream& out, uint64_t capacity = 0u )
+{
+  static_assert( std::is_same_v<Simulator, partial_simulator> || std::is_same_v<Simulator, bit_packed_simulator>, "This function is specialized for partial_simulator or bit_packed_simulator" );
+
+  auto const& patterns = sim.get_patterns();
+  const uint64_t num_words = std::max<uint64_t>( 1u, ( std::max<uint64_t>( capacity, sim.num_bits() ) + 63u ) >> 6 );
+  const auto header = detail::make_binary_patterns_header( static_cast<uint32_t>( patterns.size() ), sim.num_bits(), num_words );
+  out.write( reinterpret_cast<char const*>( &header ), sizeof( header ) );
+
+  std::vector<uint64_t> row( num_words );
+  for ( auto const& pattern : patterns )
+  {
+    std::fill( std::copy( pattern.begin(), pattern.end(), row.begin() ), row.end(), uint64_t( 0 ) );
+    out.write( reinterpret_cast<char const*>( row.data() ), row.size() * sizeof( uint64_t ) );
+  }
+}
+
+/*! \brief Writes simulation patterns in binary format
+ *
+ * \param sim The `partial_simulator` or `bit_packed_simulator` object containing simulation patterns
+ * \param filename Filename
+ * \param capacity Minimum number of patterns that fit in the file
+ */
+template<class Simulator>
+void write_binary_patterns( Simulator const& sim, std::string const& filename, uint64_t capacity = 0u )
+{
+  std::ofstream os( filename.c_str(), std::ofstream::out | std::ofstream::binary );
+  write_binary_patterns( sim, os, capacity );
+  os.close();
+}
+
 } /* namespace mockturtle */
\ No newline at end of file
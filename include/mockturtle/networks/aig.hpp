@@ -47,9 +47,11 @@
 #include <kitty/partial_truth_table.hpp>
 #include <kitty/operators.hpp>
 
+#include <limits>
 #include <list>
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <stack>
 #include <string>
 
@@ -93,15 +95,38 @@ using aig_storage = storage<regular_node<2, 2, 1>,
                             aig_storage_data,
                             aig_hash<regular_node<2, 2, 1>>>;
 
-class aig_network
+/*! \brief Compact AIG storage container
+
+  Same as `aig_storage`, but child pointers are stored in 32-bit words,
+  which reduces the size of a node from 32 to 24 bytes and the size of a
+  hash table entry from 40 to 32 bytes.  The index of a node is limited to
+  31 bits, i.e., the network can have at most 2^31 nodes; creating more
+  nodes throws `std::length_error`.
+
+  The data words are the same as in `aig_storage`: the fan-out size,
+  the application-specific value, and the visited flag are 32-bit values of
+  the network interface, so they are not narrowed.  Altogether, the storage
+  takes about 80% of the memory of `aig_storage`.
+*/
+using compact_aig_storage = storage<regular_node<2, 2, 1, uint32_t>,
+                                    aig_storage_data,
+                                    aig_hash<regular_node<2, 2, 1, uint32_t>>>;
+
+/*! \brief AIG network parameterized by its storage container
+
+  Use `aig_network` for the default storage and `compact_aig_network` for
+  the storage with 32-bit child pointers.
+*/
+template<class Storage>
+class basic_aig_network
 {
 public:
 #pragma region Types and constructors
   static constexpr auto min_fanin_size = 2u;
   static constexpr auto max_fanin_size = 2u;
 
-  using base_type = aig_network;
-  using storage = std::shared_ptr<aig_storage>;
+  using base_type = basic_aig_network;
+  using storage = std::shared_ptr<Storage>;
   using node = uint64_t;
 
   struct signal
@@ -118,7 +143,7 @@ public:
     {
     }
 
-    signal( aig_storage::node_type::pointer_type const& p )
+    signal( typename Storage::node_type::pointer_type const& p )
         : complement( p.weight ), index( p.index )
     {
     }
@@ -167,28 +192,28 @@ public:
       return data < other.data;
     }
 
-    operator aig_storage::node_type::pointer_type() const
+    operator typename Storage::node_type::pointer_type() const
     {
       return {index, complement};
     }
 
 #if __cplusplus > 201703L
-    bool operator==( aig_storage::node_type::pointer_type const& other ) const
+    bool operator==( typename Storage::node_type::pointer_type const& other ) const
     {
       return data == other.data;
     }
 #endif
   };
 
-  aig_network()
-      : _storage( std::make_shared<aig_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  basic_aig_network()
+      : _storage( std::make_shared<Storage>() ),
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
 
-  aig_network( std::shared_ptr<aig_storage> storage )
+  basic_aig_network( std::shared_ptr<Storage> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
 #pragma endregion
@@ -204,6 +229,7 @@ public:
     (void)name;
 
     const auto index = _storage->nodes.size();
+    check_index( index );
     auto& node = _storage->nodes.emplace_back();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
     _storage->inputs.emplace_back( index );
@@ -228,6 +254,7 @@ public:
     (void)name;
 
     auto const index = _storage->nodes.size();
+    check_index( index );
     auto& node = _storage->nodes.emplace_back();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
     _storage->inputs.emplace_back( index );
@@ -316,10 +343,16 @@ public:
       return a.complement ? b : get_constant( false );
     }
 
-    storage::element_type::node_type node;
+    typename Storage::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
+    /* structural hashing from several threads */
+    if ( _storage->concurrent_hash )
+    {
+      return {_storage->concurrent_hash->find_or_insert( node, _storage->hash, _storage->nodes ), 0};
+    }
+
     /* structural hashing */
     const auto it = _storage->hash.find( node );
     if ( it != _storage->hash.end() )
@@ -329,6 +362,7 @@ public:
     }
 
     const auto index = _storage->nodes.size();
+    check_index( index );
 
     if ( index >= .9 * _storage->nodes.capacity() )
     {
@@ -344,6 +378,11 @@ public:
     _storage->nodes[a.index].data[0].h1++;
     _storage->nodes[b.index].data[0].h1++;
 
+    if ( _storage->fanout_index.enabled )
+    {
+      _storage->fanout_index.add_parent( index, _storage->nodes[index].children );
+    }
+
     for ( auto const& fn : _events->on_add )
     {
       (*fn)( index );
@@ -439,7 +478,7 @@ public:
 #pragma endregion
 
 #pragma region Create arbitrary functions
-  signal clone_node( aig_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_aig_network const& other, node const& source, std::vector<signal> const& children )
   {
     (void)other;
     (void)source;
@@ -490,7 +529,7 @@ public:
     }
 
     // node already in hash table
-    storage::element_type::node_type _hash_obj;
+    typename Storage::node_type _hash_obj;
     _hash_obj.children[0] = child0;
     _hash_obj.children[1] = child1;
     if ( const auto it = _storage->hash.find( _hash_obj ); it != _storage->hash.end() && it->second != old_node )
@@ -513,6 +552,12 @@ public:
     // update the reference counter of the new signal
     _storage->nodes[new_signal.index].data[0].h1++;
 
+    // update the fanout index
+    if ( _storage->fanout_index.enabled )
+    {
+      _storage->fanout_index.update_parent( n, _storage->nodes[n].children );
+    }
+
     for ( auto const& fn : _events->on_modified )
     {
       (*fn)( n, {old_child0, old_child1} );
@@ -553,6 +598,11 @@ public:
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
 
+    if ( _storage->fanout_index.enabled )
+    {
+      _storage->fanout_index.remove_node( n );
+    }
+
     for ( auto const& fn : _events->on_delete )
     {
       (*fn)( n );
@@ -588,14 +638,27 @@ public:
       const auto [_old, _new] = to_substitute.top();
       to_substitute.pop();
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
+      if ( _storage->fanout_index.enabled )
       {
-        if ( is_ci( idx ) || is_dead( idx ) )
-          continue; /* ignore CIs */
-
-        if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
+        /* only visit the parents of the old node */
+        _storage->fanout_index.foreach_parent( _old, [&]( auto const& idx ) {
+          if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
+          {
+            to_substitute.push( *repl );
+          }
+        } );
+      }
+      else
+      {
+        for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
         {
-          to_substitute.push( *repl );
+          if ( is_ci( idx ) || is_dead( idx ) )
+            continue; /* ignore CIs */
+
+          if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
+          {
+            to_substitute.push( *repl );
+          }
         }
       }
 
@@ -610,96 +673,285 @@ public:
     }
   }
 
-  void substitute_nodes( std::list<std::pair<node, signal>> substitutions )
+  /*! \brief Performs multiple node-signal replacements.
+   *
+   * The substitutions are kept in a node-indexed hash map and applied in
+   * one sweep over the nodes in index order.  Nodes that become trivial or
+   * structurally equal to another node while replacing their fanins are
+   * added to the pending substitutions on the fly.  Another sweep is only
+   * needed if the network contains fanins with a larger index than their
+   * fanout and new substitutions have been found.
+   *
+   * \return Number of gates whose fanins have been rewritten (gates that
+   *         are substituted themselves are not counted)
+   */
+  uint32_t substitute_nodes( std::list<std::pair<node, signal>> const& substitutions )
   {
-    auto clean_substitutions = [&]( node const& n )
-    {
-      substitutions.erase( std::remove_if( std::begin( substitutions ), std::end( substitutions ),
-                                           [&]( auto const& s ){
-                                             if ( s.first == n )
-                                             {
-                                               node const nn = get_node( s.second );
-                                               if ( is_dead( nn ) )
-                                                 return true;
-
-                                               /* deref fanout_size of the node */
-                                               if ( fanout_size( nn ) > 0 )
-                                               {
-                                                 decr_fanout_size( nn );
-                                               }
-                                               /* remove the node if it's fanout_size becomes 0 */
-                                               if ( fanout_size( nn ) == 0 )
-                                               {
-                                                 take_out_node( nn );
-                                               }
-                                               /* remove substitution from list */
-                                               return true;
-                                             }
-                                             return false; /* keep */
-                                           } ),
-                           std::end( substitutions ) );
-    };
-
-    /* register event to delete substitutions if their right-hand side
-       nodes get deleted */
-    auto clean_sub_event = _events->register_delete_event( clean_substitutions );
+    phmap::flat_hash_map<node, signal> pending;
+    pending.reserve( substitutions.size() );
 
     /* increment fanout_size of all signals to be used in
        substitutions to ensure that they will not be deleted */
-    for ( const auto& s : substitutions )
+    for ( auto const& [old_node, new_signal] : substitutions )
     {
-      incr_fanout_size( get_node( s.second ) );
+      assert( old_node != get_node( new_signal ) );
+      if ( const auto it = pending.find( old_node ); it != pending.end() )
+      {
+        decr_fanout_size( get_node( it->second ) );
+      }
+      pending[old_node] = new_signal;
+      incr_fanout_size( get_node( new_signal ) );
     }
 
-    while ( !substitutions.empty() )
-    {
-      auto const [old_node, new_signal] = substitutions.front();
-      substitutions.pop_front();
+    /* follows chains of substitutions */
+    auto const resolve = [&]( signal f ) {
+      for ( auto it = pending.find( get_node( f ) ); it != pending.end(); it = pending.find( get_node( f ) ) )
+      {
+        f = it->second ^ is_complemented( f );
+      }
+      return f;
+    };
 
+    /* a gate may be rewritten again in another sweep */
+    phmap::flat_hash_set<node> rewritten;
+    bool backward_fanin{false};
+    uint32_t num_new_pending{0u};
+    do
+    {
+      num_new_pending = 0u;
       for ( auto index = 1u; index < _storage->nodes.size(); ++index )
       {
-        /* skip CIs and dead nodes */
-        if ( is_ci( index ) || is_dead( index ) )
+        /* skip CIs, dead nodes, and nodes that will be deleted */
+        if ( is_ci( index ) || is_dead( index ) || pending.count( index ) )
           continue;
 
-        /* skip nodes that will be deleted */
-        if ( std::find_if( std::begin( substitutions ), std::end( substitutions ),
-                           [&index]( auto s ){ return s.first == index; } ) != std::end( substitutions ) )
-          continue;
-
-        /* replace in node */
-        if ( const auto repl = replace_in_node( index, old_node, new_signal ); repl )
+        while ( true )
         {
-          incr_fanout_size( get_node( repl->second ) );
-          substitutions.emplace_back( *repl );
+          /* children may be reordered after each replacement */
+          auto const& children = _storage->nodes[index].children;
+          backward_fanin |= children[0].index > index || children[1].index > index;
+
+          auto const child = pending.count( children[0].index ) ? children[0].index : children[1].index;
+          if ( !pending.count( child ) )
+            break;
+
+          if ( const auto repl = replace_in_node( index, child, resolve( make_signal( child ) ) ); repl )
+          {
+            /* node becomes redundant, substitute it as well */
+            incr_fanout_size( get_node( repl->second ) );
+            pending[index] = repl->second;
+            ++num_new_pending;
+            break;
+          }
+          rewritten.insert( index );
         }
       }
+    } while ( backward_fanin && num_new_pending > 0u );
 
-      /* replace in outputs */
-      replace_in_outputs( old_node, new_signal );
-
-      /* replace in substitutions */
-      for ( auto& s : substitutions )
+    /* replace in outputs */
+    for ( auto& output : _storage->outputs )
+    {
+      if ( pending.count( output.index ) )
       {
-        if ( get_node( s.second ) == old_node )
-        {
-          s.second = is_complemented( s.second ) ? !new_signal : new_signal;
-          incr_fanout_size( get_node( new_signal ) );
-        }
+        auto const new_signal = resolve( signal( output.index, 0 ) );
+        output.index = new_signal.index;
+        output.weight ^= new_signal.complement;
+        incr_fanout_size( new_signal.index );
       }
+    }
 
-      /* finally remove the node: note that we never decrement the
-         fanout_size of the old_node. instead, we remove the node and
-         reset its fanout_size to 0 knowing that it must be 0 after
-         substituting all references. */
-      assert( !is_dead( old_node ) );
+    /* finally remove the nodes in index order: note that we never
+       decrement the fanout_size of the old nodes. instead, we remove
+       them knowing that they must be 0 after substituting all
+       references. */
+    std::vector<std::pair<node, signal>> done( pending.begin(), pending.end() );
+    std::sort( done.begin(), done.end(), []( auto const& a, auto const& b ) { return a.first < b.first; } );
+    for ( auto const& [old_node, new_signal] : done )
+    {
       take_out_node( old_node );
+    }
+
+    /* decrement fanout_size when released from substitution list */
+    for ( auto const& [old_node, new_signal] : done )
+    {
+      (void)old_node;
+      auto const n = get_node( new_signal );
+      if ( is_dead( n ) || fanout_size( n ) == 0 )
+        continue;
+      if ( decr_fanout_size( n ) == 0 )
+      {
+        take_out_node( n );
+      }
+    }
+
+    return static_cast<uint32_t>( rewritten.size() );
+  }
+
+  /*! \brief Enables the fanout index of the storage.
+   *
+   * The index is built from the current network and maintained by
+   * `create_*`, `replace_in_node`, and `take_out_node` afterwards.  While
+   * the index is enabled, `substitute_node` only visits the fanouts of the
+   * substituted node instead of scanning all nodes.
+   */
+  void enable_fanout_index()
+  {
+    _storage->fanout_index.enabled = true;
+    _storage->fanout_index.fanouts.build( *this );
+  }
+
+  /*! \brief Disables the fanout index and releases its memory. */
+  void disable_fanout_index()
+  {
+    _storage->fanout_index.enabled = false;
+    _storage->fanout_index.fanouts.clear();
+  }
+
+  bool has_fanout_index() const
+  {
+    return _storage->fanout_index.enabled;
+  }
+
+  /*! \brief Enables concurrent structural hashing.
+   *
+   * Afterwards, `create_and` can be called from several threads at the same
+   * time and still return canonical strashed nodes.  Slots for at most
+   * `max_new_nodes` new nodes are pre-allocated at the end of the node
+   * array; creating more new nodes throws `std::length_error`, and so does
+   * this method if the slots exceed the index limit of the storage.  No other
+   * method may modify the network until concurrent structural hashing is
+   * disabled again.  Until then, `size()` includes all pre-allocated slots,
+   * of which the unused ones look like CIs (both children are equal), and
+   * fanout sizes and `on_add` events do not reflect the new nodes.
+   */
+  void enable_concurrent_strash( uint64_t max_new_nodes )
+  {
+    assert( !_storage->concurrent_hash );
+    const auto num_nodes = _storage->nodes.size();
+    if ( max_new_nodes > 0u )
+    {
+      check_index( num_nodes + max_new_nodes - 1u );
+    }
+    _storage->concurrent_hash = std::make_unique<typename decltype( _storage->concurrent_hash )::element_type>( num_nodes );
+    _storage->nodes.resize( num_nodes + max_new_nodes );
+  }
+
+  /*! \brief Merges the concurrently created nodes into the network.
+   *
+   * New nodes are added to the structural hash table and to the fanout
+   * sizes of their children, and `on_add` events are triggered for them in
+   * index order.
+   */
+  void disable_concurrent_strash()
+  {
+    assert( _storage->concurrent_hash );
+    const auto first = _storage->concurrent_hash->first_new_node;
+    const auto last = _storage->concurrent_hash->size( _storage->nodes.size() );
+    _storage->concurrent_hash.reset();
+    _storage->nodes.resize( last );
+
+    for ( auto index = first; index < last; ++index )
+    {
+      auto const& n = _storage->nodes[index];
+      _storage->hash[n] = index;
+      for ( auto const& c : n.children )
+      {
+        _storage->nodes[c.index].data[0].h1++;
+      }
+      if ( _storage->fanout_index.enabled )
+      {
+        _storage->fanout_index.add_parent( index, n.children );
+      }
+    }
 
-      /* decrement fanout_size when released from substitution list */
-      decr_fanout_size( get_node( new_signal ) );
+    for ( auto index = first; index < last; ++index )
+    {
+      for ( auto const& fn : _events->on_add )
+      {
+        (*fn)( index );
+      }
     }
+  }
 
-    _events->release_delete_event( clean_sub_event );
+  bool has_concurrent_strash() const
+  {
+    return _storage->concurrent_hash != nullptr;
+  }
+
+  /*! \brief Removes dead nodes from the storage in-place.
+   *
+   * Live nodes are renumbered without changing their relative order.  The
+   * children of all gates, the CIs, and the COs are updated and the
+   * structural hash table is rebuilt.  The capacity of the node array is
+   * kept for nodes that are created later.  Node indexes that are stored
+   * outside of the network, e.g., in views or node maps, become invalid.
+   *
+   * \return Map from old to new node indexes, in which dead nodes are
+   *         mapped to `std::numeric_limits<node>::max()`
+   */
+  std::vector<node> compact()
+  {
+    auto& nodes = _storage->nodes;
+    std::vector<node> old_to_new( nodes.size(), std::numeric_limits<node>::max() );
+
+    node num_live{0};
+    for ( node i = 0u; i < nodes.size(); ++i )
+    {
+      if ( !is_dead( i ) )
+      {
+        old_to_new[i] = num_live++;
+      }
+    }
+
+    if ( num_live == nodes.size() )
+    {
+      return old_to_new;
+    }
+
+    /* nodes are only moved towards the front, so that each slot is
+       overwritten after it has been read */
+    _storage->hash.clear();
+    _storage->hash.reserve( num_live );
+    for ( node i = 0u; i < nodes.size(); ++i )
+    {
+      auto const n = old_to_new[i];
+      if ( n == std::numeric_limits<node>::max() )
+        continue;
+
+      if ( n != i )
+      {
+        nodes[n] = nodes[i];
+      }
+
+      if ( n == 0 || is_ci( n ) )
+        continue;
+
+      for ( auto& child : nodes[n].children )
+      {
+        assert( old_to_new[child.index] != std::numeric_limits<node>::max() );
+        child.index = old_to_new[child.index];
+      }
+      _storage->hash[nodes[n]] = n;
+    }
+    nodes.resize( num_live );
+
+    for ( auto& ci : _storage->inputs )
+    {
+      ci = old_to_new[ci];
+    }
+
+    for ( auto& output : _storage->outputs )
+    {
+      assert( old_to_new[output.index] != std::numeric_limits<node>::max() );
+      output.index = old_to_new[output.index];
+    }
+
+    if ( _storage->fanout_index.enabled )
+    {
+      enable_fanout_index();
+    }
+
+    return old_to_new;
   }
 #pragma endregion
 
@@ -1227,11 +1479,24 @@ public:
   }
 #pragma endregion
 
+private:
+  /* throws if a node with index `index` does not fit into the child pointers */
+  static void check_index( uint64_t index )
+  {
+    if ( index > Storage::node_type::pointer_type::max_index )
+    {
+      throw std::length_error( "the network exceeds the number of nodes of its storage" );
+    }
+  }
+
 public:
-  std::shared_ptr<aig_storage> _storage;
+  std::shared_ptr<Storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
 };
 
+using aig_network = basic_aig_network<aig_storage>;
+using compact_aig_network = basic_aig_network<compact_aig_storage>;
+
 } // namespace mockturtle
 
 namespace std
@@ -1252,4 +1517,13 @@ struct hash<mockturtle::aig_network::signal>
   }
 }; /* hash */
 
+template<>
+struct hash<mockturtle::compact_aig_network::signal>
+{
+  uint64_t operator()( mockturtle::compact_aig_network::signal const &s ) const noexcept
+  {
+    return hash<mockturtle::aig_network::signal>{}( mockturtle::aig_network::signal( s.data ) );
+  }
+}; /* hash */
+
 } // namespace std
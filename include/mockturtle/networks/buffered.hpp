@@ -86,7 +86,7 @@ public:
   void replace_in_outputs( node const& old_node, signal const& new_signal ) = delete;
   void take_out_node( node const& n ) = delete;
   void substitute_node( node const& old_node, signal const& new_signal ) = delete;
-  void substitute_nodes( std::list<std::pair<node, signal>> substitutions ) = delete;
+  uint32_t substitute_nodes( std::list<std::pair<node, signal>> const& substitutions ) = delete;
 #pragma endregion
 
 #pragma region Structural properties
@@ -318,7 +318,7 @@ public:
   void replace_in_outputs( node const& old_node, signal const& new_signal ) = delete;
   void take_out_node( node const& n ) = delete;
   void substitute_node( node const& old_node, signal const& new_signal ) = delete;
-  void substitute_nodes( std::list<std::pair<node, signal>> substitutions ) = delete;
+  uint32_t substitute_nodes( std::list<std::pair<node, signal>> const& substitutions ) = delete;
 #pragma endregion
 
 #pragma region Structural properties
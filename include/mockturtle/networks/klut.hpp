@@ -46,6 +46,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <type_traits>
 
 namespace mockturtle
 {
@@ -80,28 +81,61 @@ struct klut_storage_node : mixed_fanin_node<2>
 */
 using klut_storage = storage<klut_storage_node, klut_storage_data>;
 
-class klut_network
+/*! \brief k-LUT storage data with a fan-in arena */
+struct arena_klut_storage_data : klut_storage_data
+{
+  fanin_arena<node_pointer<0>> fanins;
+};
+
+/*! \brief k-LUT node with fan-ins in an arena
+ *
+ * Same data layout as `klut_storage_node`.
+ */
+struct arena_klut_storage_node : arena_fanin_node<2>
+{
+  bool operator==( arena_klut_storage_node const& other ) const
+  {
+    return data[1].h1 == other.data[1].h1 && children == other.children;
+  }
+};
+
+/*! \brief Arena-based k-LUT storage container
+
+  Same as `klut_storage`, but the fan-ins of all nodes are stored in large
+  contiguous blocks of `data.fanins` instead of one vector per node.  This
+  avoids a heap allocation per node (and per hash table entry) and keeps
+  the fan-ins of consecutively created nodes next to each other in memory.
+*/
+using arena_klut_storage = storage<arena_klut_storage_node, arena_klut_storage_data>;
+
+/*! \brief k-LUT network parameterized by its storage container
+
+  Use `klut_network` for the default storage and `arena_klut_network` for
+  the storage with arena-allocated fan-ins.
+*/
+template<class Storage>
+class basic_klut_network
 {
 public:
 #pragma region Types and constructors
   static constexpr auto min_fanin_size = 1;
   static constexpr auto max_fanin_size = 32;
 
-  using base_type = klut_network;
-  using storage = std::shared_ptr<klut_storage>;
+  using base_type = basic_klut_network;
+  using storage = std::shared_ptr<Storage>;
   using node = uint64_t;
   using signal = uint64_t;
 
-  klut_network()
-      : _storage( std::make_shared<klut_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  basic_klut_network()
+      : _storage( std::make_shared<Storage>() ),
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
     _init();
   }
 
-  klut_network( std::shared_ptr<klut_storage> storage )
+  basic_klut_network( std::shared_ptr<Storage> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
     _init();
   }
@@ -343,13 +377,27 @@ signal create_maj( signal a, signal b, signal c )
 #pragma region Create arbitrary functions
   signal _create_node( std::vector<signal> const& children, uint32_t literal )
   {
-    storage::element_type::node_type node;
-    std::copy( children.begin(), children.end(), std::back_inserter( node.children ) );
+    typename Storage::node_type node;
+    if constexpr ( std::is_same_v<typename Storage::node_type, arena_klut_storage_node> )
+    {
+      /* allocate the fan-ins up front and give them back if the node exists */
+      node.children.count = static_cast<uint32_t>( children.size() );
+      node.children.first = _storage->data.fanins.allocate( node.children.count );
+      std::copy( children.begin(), children.end(), node.children.begin() );
+    }
+    else
+    {
+      std::copy( children.begin(), children.end(), std::back_inserter( node.children ) );
+    }
     node.data[1].h1 = literal;
 
     const auto it = _storage->hash.find( node );
     if ( it != _storage->hash.end() )
     {
+      if constexpr ( std::is_same_v<typename Storage::node_type, arena_klut_storage_node> )
+      {
+        _storage->data.fanins.release_last( node.children.count );
+      }
       return it->second;
     }
 
@@ -383,7 +431,7 @@ signal create_maj( signal a, signal b, signal c )
     return _create_node( children, _storage->data.cache.insert( function ) );
   }
 
-  signal clone_node( klut_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_klut_network const& other, node const& source, std::vector<signal> const& children )
   {
     assert( !children.empty() );
     const auto tt = other._storage->data.cache[other._storage->nodes[source].data[1].h1];
@@ -398,10 +446,26 @@ signal create_maj( signal a, signal b, signal c )
     for ( auto i = 0u; i < _storage->nodes.size(); ++i )
     {
       auto& n = _storage->nodes[i];
+      bool modified = false, rehash = false;
       for ( auto& child : n.children )
       {
         if ( child == old_node )
         {
+          if constexpr ( std::is_same_v<typename Storage::node_type, arena_klut_storage_node> )
+          {
+            /* the hash key shares the fan-ins of the node, so take it out
+               before the fan-ins change */
+            if ( !modified )
+            {
+              if ( const auto it = _storage->hash.find( n ); it != _storage->hash.end() && it->second == i )
+              {
+                _storage->hash.erase( it );
+                rehash = true;
+              }
+            }
+          }
+          modified = true;
+
           std::vector<signal> old_children( n.children.size() );
           std::transform( n.children.begin(), n.children.end(), old_children.begin(), []( auto c ) { return c.index; } );
           child = new_signal;
@@ -415,6 +479,12 @@ signal create_maj( signal a, signal b, signal c )
           }
         }
       }
+
+      if ( rehash )
+      {
+        /* keep an existing node with the same fan-ins and function */
+        _storage->hash.emplace( n, i );
+      }
     }
 
     /* check outputs */
@@ -740,7 +810,7 @@ signal create_maj( signal a, signal b, signal c )
     if ( n == 0 || is_ci( n ) )
       return;
 
-    using IteratorType = decltype( _storage->outputs.begin() );
+    using IteratorType = decltype( _storage->nodes[n].children.begin() );
     detail::foreach_element_transform<IteratorType, uint32_t>( _storage->nodes[n].children.begin(), _storage->nodes[n].children.end(), []( auto f ) { return f.index; }, fn );
   }
 #pragma endregion
@@ -852,8 +922,11 @@ signal create_maj( signal a, signal b, signal c )
 #pragma endregion
 
 public:
-  std::shared_ptr<klut_storage> _storage;
+  std::shared_ptr<Storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
 };
 
+using klut_network = basic_klut_network<klut_storage>;
+using arena_klut_network = basic_klut_network<arena_klut_storage>;
+
 } // namespace mockturtle
@@ -352,6 +352,11 @@ public:
     _storage->nodes[b.index].data[0].h1++;
     _storage->nodes[c.index].data[0].h1++;
 
+    if ( _storage->fanout_index.enabled )
+    {
+      _storage->fanout_index.add_parent( index, _storage->nodes[index].children );
+    }
+
     for ( auto const& fn : _events->on_add )
     {
       (*fn)( index );
@@ -532,6 +537,12 @@ public:
     // update the reference counter of the new signal
     _storage->nodes[new_signal.index].data[0].h1++;
 
+    // update the fanout index
+    if ( _storage->fanout_index.enabled )
+    {
+      _storage->fanout_index.update_parent( n, _storage->nodes[n].children );
+    }
+
     for ( auto const& fn : _events->on_modified )
     {
       (*fn)( n, {old_child0, old_child1, old_child2} );
@@ -571,6 +582,11 @@ public:
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
 
+    if ( _storage->fanout_index.enabled )
+    {
+      _storage->fanout_index.remove_node( n );
+    }
+
     for ( auto const& fn : _events->on_delete )
     {
       (*fn)( n );
@@ -604,14 +620,27 @@ public:
       const auto [_old, _new] = to_substitute.top();
       to_substitute.pop();
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
+      if ( _storage->fanout_index.enabled )
       {
-        if ( is_ci( idx ) || is_dead( idx ) )
-          continue; /* ignore CIs */
-
-        if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
+        /* only visit the parents of the old node */
+        _storage->fanout_index.foreach_parent( _old, [&]( auto const& idx ) {
+          if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
+          {
+            to_substitute.push( *repl );
+          }
+        } );
+      }
+      else
+      {
+        for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
         {
-          to_substitute.push( *repl );
+          if ( is_ci( idx ) || is_dead( idx ) )
+            continue; /* ignore CIs */
+
+          if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
+          {
+            to_substitute.push( *repl );
+          }
         }
       }
 
@@ -642,6 +671,12 @@ public:
           _storage->nodes[old_node].data[0].h1--;
         }
       }
+
+      // update the fanout index
+      if ( _storage->fanout_index.enabled )
+      {
+        _storage->fanout_index.update_parent( p, n.children );
+      }
     }
 
     /* check outputs */
@@ -660,6 +695,31 @@ public:
       }
     }
   }
+
+  /*! \brief Enables the fanout index of the storage.
+   *
+   * The index is built from the current network and maintained by
+   * `create_*`, `replace_in_node`, and `take_out_node` afterwards.  While
+   * the index is enabled, `substitute_node` only visits the fanouts of the
+   * substituted node instead of scanning all nodes.
+   */
+  void enable_fanout_index()
+  {
+    _storage->fanout_index.enabled = true;
+    _storage->fanout_index.fanouts.build( *this );
+  }
+
+  /*! \brief Disables the fanout index and releases its memory. */
+  void disable_fanout_index()
+  {
+    _storage->fanout_index.enabled = false;
+    _storage->fanout_index.fanouts.clear();
+  }
+
+  bool has_fanout_index() const
+  {
+    return _storage->fanout_index.enabled;
+  }
 #pragma endregion
 
 #pragma region Structural properties
@@ -35,54 +35,77 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cassert>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
 #include <parallel_hashmap/phmap.h>
 
+#include "../utils/fanout_store.hpp"
+
 namespace mockturtle
 {
 
-template<int PointerFieldSize = 0>
+/*! \brief Pointer to a node with optional weight bits
+
+  The pointer is stored in a single machine word of type `Word`.  Using
+  `uint32_t` instead of the default `uint64_t` halves the size of the
+  pointer, but limits the index to `32 - PointerFieldSize` bits.
+*/
+template<int PointerFieldSize = 0, typename Word = uint64_t>
 struct node_pointer
 {
 private:
-  static constexpr auto _len = sizeof( uint64_t ) * 8;
+  static constexpr auto _len = sizeof( Word ) * 8;
 
 public:
+  /*! \brief Largest index that fits into the pointer. */
+  static constexpr uint64_t max_index = _len - PointerFieldSize >= 64u ? std::numeric_limits<uint64_t>::max() : ( UINT64_C( 1 ) << ( _len - PointerFieldSize ) ) - 1u;
+
   node_pointer() = default;
   node_pointer( uint64_t index, uint64_t weight ) : weight( weight ), index( index ) {}
 
   union {
     struct
     {
-      uint64_t weight : PointerFieldSize;
-      uint64_t index : _len - PointerFieldSize;
+      Word weight : PointerFieldSize;
+      Word index : _len - PointerFieldSize;
     };
-    uint64_t data;
+    Word data;
   };
 
-  bool operator==( node_pointer<PointerFieldSize> const& other ) const
+  bool operator==( node_pointer<PointerFieldSize, Word> const& other ) const
   {
     return data == other.data;
   }
 };
 
-template<>
-struct node_pointer<0>
+template<typename Word>
+struct node_pointer<0, Word>
 {
 public:
+  /*! \brief Largest index that fits into the pointer. */
+  static constexpr uint64_t max_index = std::numeric_limits<Word>::max();
+
   node_pointer() = default;
   node_pointer( uint64_t index ) : index( index ) {}
 
   union {
-    uint64_t index;
-    uint64_t data;
+    Word index;
+    Word data;
   };
 
-  bool operator==( node_pointer<0> const& other ) const
+  bool operator==( node_pointer<0, Word> const& other ) const
   {
     return data == other.data;
   }
@@ -104,15 +127,15 @@ union cauint64_t {
   };
 };
 
-template<int Fanin, int Size = 0, int PointerFieldSize = 0>
+template<int Fanin, int Size = 0, int PointerFieldSize = 0, typename PointerWord = uint64_t>
 struct regular_node
 {
-  using pointer_type = node_pointer<PointerFieldSize>;
+  using pointer_type = node_pointer<PointerFieldSize, PointerWord>;
 
   std::array<pointer_type, Fanin> children;
   std::array<cauint64_t, Size> data;
 
-  bool operator==( regular_node<Fanin, Size, PointerFieldSize> const& other ) const
+  bool operator==( regular_node<Fanin, Size, PointerFieldSize, PointerWord> const& other ) const
   {
     return children == other.children;
   }
@@ -132,6 +155,117 @@ struct mixed_fanin_node
   }
 };
 
+/*! \brief Block arena for fan-in pointers
+
+  Fan-ins are allocated as contiguous runs inside large blocks.  Blocks are
+  never reallocated or freed before the arena is destroyed, such that the
+  address of an allocated run stays valid while the arena grows.  Only the
+  most recent allocation can be given back with `release_last`.
+*/
+template<typename T>
+class fanin_arena
+{
+public:
+  explicit fanin_arena( uint32_t block_size = 1u << 12u )
+      : _block_size( block_size )
+  {
+  }
+
+  fanin_arena( fanin_arena const& ) = delete;
+  fanin_arena& operator=( fanin_arena const& ) = delete;
+
+  T* allocate( uint32_t size )
+  {
+    if ( _used + size > _capacity )
+    {
+      _capacity = std::max( size, _block_size );
+      _blocks.emplace_back( new T[_capacity] );
+      _used = 0u;
+      _num_bytes += sizeof( T ) * _capacity;
+    }
+
+    T* const run = _blocks.back().get() + _used;
+    _used += size;
+    return run;
+  }
+
+  void release_last( uint32_t size )
+  {
+    assert( size <= _used );
+    _used -= size;
+  }
+
+  uint64_t num_bytes() const
+  {
+    return _num_bytes;
+  }
+
+private:
+  uint32_t _block_size;
+  uint32_t _capacity{0u};
+  uint32_t _used{0u};
+  uint64_t _num_bytes{0u};
+  std::vector<std::unique_ptr<T[]>> _blocks;
+};
+
+/*! \brief Fan-in range of a node that lives in a `fanin_arena` */
+template<typename PointerType>
+struct arena_fanin_range
+{
+  PointerType* first{nullptr};
+  uint32_t count{0u};
+
+  PointerType* begin() const
+  {
+    return first;
+  }
+
+  PointerType* end() const
+  {
+    return first + count;
+  }
+
+  std::size_t size() const
+  {
+    return count;
+  }
+
+  bool empty() const
+  {
+    return count == 0u;
+  }
+
+  PointerType& operator[]( std::size_t i ) const
+  {
+    return first[i];
+  }
+
+  bool operator==( arena_fanin_range<PointerType> const& other ) const
+  {
+    return count == other.count && std::equal( begin(), end(), other.begin() );
+  }
+};
+
+/*! \brief Node with a variable number of fan-ins stored in an arena
+
+  Same as `mixed_fanin_node`, but the children are an address and a length
+  into a `fanin_arena` of the storage instead of a separately allocated
+  vector per node.
+*/
+template<int Size = 0, int PointerFieldSize = 0>
+struct arena_fanin_node
+{
+  using pointer_type = node_pointer<PointerFieldSize>;
+
+  arena_fanin_range<pointer_type> children;
+  std::array<cauint64_t, Size> data;
+
+  bool operator==( arena_fanin_node<Size, PointerFieldSize> const& other ) const
+  {
+    return children == other.children;
+  }
+};
+
 /*! \brief Hash function for 64-bit word */
 inline uint64_t hash_block( uint64_t word )
 {
@@ -189,6 +323,155 @@ struct empty_storage_data
 {
 };
 
+/*! \brief Optional fanout index of a storage container
+
+  The index keeps for every node the list of gates that use it as a fan-in,
+  in the pooled fanout lists of `detail::fanout_store`.  It is disabled by
+  default; once enabled, the network implementation keeps it up-to-date
+  when creating, modifying, or deleting gates.
+*/
+struct storage_fanout_index
+{
+  /*! \brief Adds gate `parent` to the fanout lists of its children. */
+  template<typename Children>
+  void add_parent( uint64_t parent, Children const& children )
+  {
+    std::array<uint32_t, std::tuple_size_v<Children>> fanins;
+    std::transform( children.begin(), children.end(), fanins.begin(), []( auto const& c ) {
+      return static_cast<uint32_t>( c.index );
+    } );
+    fanouts.resize( static_cast<uint32_t>( parent + 1u ) );
+    fanouts.add_parent( static_cast<uint32_t>( parent ), fanins );
+  }
+
+  /*! \brief Moves gate `parent` to the fanout lists of its new children. */
+  template<typename Children>
+  void update_parent( uint64_t parent, Children const& children )
+  {
+    fanouts.resize( static_cast<uint32_t>( parent + 1u ) );
+    fanouts.remove_parent( static_cast<uint32_t>( parent ) );
+    add_parent( parent, children );
+  }
+
+  /*! \brief Removes gate `n` from the index, and all its fanouts. */
+  void remove_node( uint64_t n )
+  {
+    if ( n >= fanouts.num_nodes() )
+    {
+      return;
+    }
+    fanouts.clear_fanouts( static_cast<uint32_t>( n ) );
+    fanouts.remove_parent( static_cast<uint32_t>( n ) );
+  }
+
+  /*! \brief Calls `fn` for each fanout of `n`.
+   *
+   * The fanouts are visited from the end of the list, such that `fn` may
+   * remove the visited fanout from the list, or add fanouts to other nodes.
+   */
+  template<typename Fn>
+  void foreach_parent( uint64_t n, Fn&& fn ) const
+  {
+    if ( n >= fanouts.num_nodes() )
+    {
+      return;
+    }
+    for ( auto i = fanouts.size( static_cast<uint32_t>( n ) ); i-- > 0u; )
+    {
+      fn( static_cast<uint64_t>( fanouts.begin( static_cast<uint32_t>( n ) )[i].parent ) );
+    }
+  }
+
+  /*! \brief Returns a sorted copy of the fanouts of `n`. */
+  std::vector<uint64_t> parents( uint64_t n ) const
+  {
+    std::vector<uint64_t> copy;
+    if ( n >= fanouts.num_nodes() )
+    {
+      return copy;
+    }
+    std::transform( fanouts.begin( static_cast<uint32_t>( n ) ), fanouts.end( static_cast<uint32_t>( n ) ), std::back_inserter( copy ), []( auto const& e ) {
+      return static_cast<uint64_t>( e.parent );
+    } );
+    std::sort( copy.begin(), copy.end() );
+    return copy;
+  }
+
+  bool enabled{false};
+  detail::fanout_store fanouts;
+};
+
+/*! \brief Structural hash table for concurrent node construction
+
+  While it exists, nodes are looked up in the (then read-only) hash table
+  of the storage first and otherwise in a sharded hash map, in which every
+  submap is protected by its own mutex.  A new node is written into the
+  next free pre-allocated slot of `nodes`, which is claimed by atomically
+  incrementing `num_nodes`.  The network merges new nodes back into the
+  storage once concurrent construction ends.
+
+  If all slots are taken, the node is recorded with the index `exhausted`
+  and `find_or_insert` throws `std::length_error`, also for every later
+  lookup of the same node.
+*/
+template<typename Node, typename NodeHasher>
+struct storage_concurrent_hash
+{
+  storage_concurrent_hash( uint64_t num_nodes )
+      : first_new_node( num_nodes ), num_nodes( num_nodes )
+  {
+  }
+
+  static constexpr uint64_t exhausted = std::numeric_limits<uint64_t>::max();
+
+  /*! \brief Returns the index of `node`, appending it if it does not exist. */
+  uint64_t find_or_insert( Node const& node,
+                           phmap::flat_hash_map<Node, uint64_t, NodeHasher> const& hash,
+                           std::vector<Node>& nodes )
+  {
+    if ( const auto it = hash.find( node ); it != hash.end() )
+    {
+      return it->second;
+    }
+
+    uint64_t index{};
+    new_nodes.lazy_emplace_l(
+        node,
+        [&]( auto const& value ) { index = value; },
+        [&]( auto const& ctor ) {
+          index = num_nodes.fetch_add( 1u );
+          if ( index < nodes.size() )
+          {
+            nodes[index] = node;
+          }
+          else
+          {
+            /* the slot is prepared by the map, so it must be constructed */
+            index = exhausted;
+          }
+          ctor( node, index );
+        } );
+
+    if ( index == exhausted )
+    {
+      throw std::length_error( "capacity for concurrent construction is exhausted" );
+    }
+    return index;
+  }
+
+  /*! \brief Returns the number of nodes including the new ones. */
+  uint64_t size( uint64_t capacity ) const
+  {
+    return std::min<uint64_t>( num_nodes.load(), capacity );
+  }
+
+  uint64_t first_new_node;
+  std::atomic<uint64_t> num_nodes;
+  phmap::parallel_flat_hash_map<Node, uint64_t, NodeHasher, phmap::priv::hash_default_eq<Node>,
+                                phmap::priv::Allocator<phmap::priv::Pair<const Node, uint64_t>>, 4, std::mutex>
+      new_nodes;
+};
+
 template<typename Node, typename T = empty_storage_data, typename NodeHasher = node_hash<Node>>
 struct storage
 {
@@ -210,6 +493,9 @@ struct storage
 
   phmap::flat_hash_map<node_type, uint64_t, NodeHasher> hash;
 
+  storage_fanout_index fanout_index;
+  std::unique_ptr<storage_concurrent_hash<node_type, NodeHasher>> concurrent_hash;
+
   T data;
 };
 
@@ -40,6 +40,7 @@
 
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <stack>
 #include <string>
 
@@ -92,15 +93,37 @@ using xag_storage = storage<regular_node<2, 2, 1>,
                             xag_storage_data,
                             xag_hash<regular_node<2, 2, 1>>>;
 
-class xag_network
+/*! \brief Compact XAG storage container
+
+  Same as `xag_storage`, but child pointers are stored in 32-bit words,
+  which reduces the size of a node from 32 to 24 bytes.  The index of a
+  node is limited to 31 bits, i.e., the network can have at most 2^31
+  nodes; creating more nodes throws `std::length_error`.
+
+  The data words are the same as in `xag_storage`: the fan-out size, the
+  application-specific value, and the visited flag are 32-bit values of the
+  network interface, so they are not narrowed.  Altogether, the storage
+  takes about 80% of the memory of `xag_storage`.
+*/
+using compact_xag_storage = storage<regular_node<2, 2, 1, uint32_t>,
+                                    xag_storage_data,
+                                    xag_hash<regular_node<2, 2, 1, uint32_t>>>;
+
+/*! \brief XAG network parameterized by its storage container
+
+  Use `xag_network` for the default storage and `compact_xag_network` for
+  the storage with 32-bit child pointers.
+*/
+template<class Storage>
+class basic_xag_network
 {
 public:
 #pragma region Types and constructors
   static constexpr auto min_fanin_size = 2u;
   static constexpr auto max_fanin_size = 2u;
 
-  using base_type = xag_network;
-  using storage = std::shared_ptr<xag_storage>;
+  using base_type = basic_xag_network;
+  using storage = std::shared_ptr<Storage>;
   using node = uint64_t;
 
   struct signal
@@ -117,7 +140,7 @@ public:
     {
     }
 
-    signal( xag_storage::node_type::pointer_type const& p )
+    signal( typename Storage::node_type::pointer_type const& p )
         : complement( p.weight ), index( p.index )
     {
     }
@@ -166,28 +189,28 @@ public:
       return data < other.data;
     }
 
-    operator xag_storage::node_type::pointer_type() const
+    operator typename Storage::node_type::pointer_type() const
     {
       return {index, complement};
     }
 
 #if __cplusplus > 201703L
-    bool operator==( xag_storage::node_type::pointer_type const& other ) const
+    bool operator==( typename Storage::node_type::pointer_type const& other ) const
     {
       return data == other.data;
     }
 #endif
   };
 
-  xag_network()
-      : _storage( std::make_shared<xag_storage>() ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+  basic_xag_network()
+      : _storage( std::make_shared<Storage>() ),
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
 
-  xag_network( std::shared_ptr<xag_storage> storage )
+  basic_xag_network( std::shared_ptr<Storage> storage )
       : _storage( storage ),
-        _events( std::make_shared<decltype( _events )::element_type>() )
+        _events( std::make_shared<typename decltype( _events )::element_type>() )
   {
   }
 #pragma endregion
@@ -203,6 +226,7 @@ public:
     (void)name;
 
     const auto index = _storage->nodes.size();
+    check_index( index );
     auto& node = _storage->nodes.emplace_back();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
     _storage->inputs.emplace_back( index );
@@ -227,6 +251,7 @@ public:
     (void)name;
 
     auto const index = _storage->nodes.size();
+    check_index( index );
     auto& node = _storage->nodes.emplace_back();
     node.children[0].data = node.children[1].data = _storage->inputs.size();
     _storage->inputs.emplace_back( index );
@@ -299,10 +324,16 @@ public:
 #pragma region Create binary functions
   signal _create_node( signal a, signal b )
   {
-    storage::element_type::node_type node;
+    typename Storage::node_type node;
     node.children[0] = a;
     node.children[1] = b;
 
+    /* structural hashing from several threads */
+    if ( _storage->concurrent_hash )
+    {
+      return {_storage->concurrent_hash->find_or_insert( node, _storage->hash, _storage->nodes ), 0};
+    }
+
     /* structural hashing */
     const auto it = _storage->hash.find( node );
     if ( it != _storage->hash.end() )
@@ -311,6 +342,7 @@ public:
     }
 
     const auto index = _storage->nodes.size();
+    check_index( index );
 
     if ( index >= .9 * _storage->nodes.capacity() )
     {
@@ -326,6 +358,11 @@ public:
     _storage->nodes[a.index].data[0].h1++;
     _storage->nodes[b.index].data[0].h1++;
 
+    if ( _storage->fanout_index.enabled )
+    {
+      _storage->fanout_index.add_parent( index, _storage->nodes[index].children );
+    }
+
     for ( auto const& fn : _events->on_add )
     {
       (*fn)( index );
@@ -457,7 +494,7 @@ public:
 #pragma endregion
 
 #pragma region Create arbitrary functions
-  signal clone_node( xag_network const& other, node const& source, std::vector<signal> const& children )
+  signal clone_node( basic_xag_network const& other, node const& source, std::vector<signal> const& children )
   {
     assert( children.size() == 2u );
     if ( other.is_and( source ) )
@@ -530,7 +567,7 @@ public:
     }
 
     // node already in hash table
-    storage::element_type::node_type _hash_obj;
+    typename Storage::node_type _hash_obj;
     _hash_obj.children[0] = child0;
     _hash_obj.children[1] = child1;
     if ( const auto it = _storage->hash.find( _hash_obj ); it != _storage->hash.end() )
@@ -553,6 +590,12 @@ public:
     // update the reference counter of the new signal
     _storage->nodes[new_signal.index].data[0].h1++;
 
+    // update the fanout index
+    if ( _storage->fanout_index.enabled )
+    {
+      _storage->fanout_index.update_parent( n, _storage->nodes[n].children );
+    }
+
     for ( auto const& fn : _events->on_modified )
     {
       (*fn)( n, {old_child0, old_child1} );
@@ -586,6 +629,11 @@ public:
     nobj.data[0].h1 = UINT32_C( 0x80000000 ); /* fanout size 0, but dead */
     _storage->hash.erase( nobj );
 
+    if ( _storage->fanout_index.enabled )
+    {
+      _storage->fanout_index.remove_node( n );
+    }
+
     for ( auto const& fn : _events->on_delete )
     {
       (*fn)( n );
@@ -619,14 +667,27 @@ public:
       const auto [_old, _new] = to_substitute.top();
       to_substitute.pop();
 
-      for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
+      if ( _storage->fanout_index.enabled )
       {
-        if ( is_ci( idx ) )
-          continue; /* ignore CIs */
-
-        if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
+        /* only visit the parents of the old node */
+        _storage->fanout_index.foreach_parent( _old, [&]( auto const& idx ) {
+          if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
+          {
+            to_substitute.push( *repl );
+          }
+        } );
+      }
+      else
+      {
+        for ( auto idx = 1u; idx < _storage->nodes.size(); ++idx )
         {
-          to_substitute.push( *repl );
+          if ( is_ci( idx ) )
+            continue; /* ignore CIs */
+
+          if ( const auto repl = replace_in_node( idx, _old, _new ); repl )
+          {
+            to_substitute.push( *repl );
+          }
         }
       }
 
@@ -637,6 +698,97 @@ public:
       take_out_node( _old );
     }
   }
+
+  /*! \brief Enables the fanout index of the storage.
+   *
+   * The index is built from the current network and maintained by
+   * `create_*`, `replace_in_node`, and `take_out_node` afterwards.  While
+   * the index is enabled, `substitute_node` only visits the fanouts of the
+   * substituted node instead of scanning all nodes.
+   */
+  void enable_fanout_index()
+  {
+    _storage->fanout_index.enabled = true;
+    _storage->fanout_index.fanouts.build( *this );
+  }
+
+  /*! \brief Disables the fanout index and releases its memory. */
+  void disable_fanout_index()
+  {
+    _storage->fanout_index.enabled = false;
+    _storage->fanout_index.fanouts.clear();
+  }
+
+  bool has_fanout_index() const
+  {
+    return _storage->fanout_index.enabled;
+  }
+
+  /*! \brief Enables concurrent structural hashing.
+   *
+   * Afterwards, `create_and` and `create_xor` can be called from several threads at the same
+   * time and still return canonical strashed nodes.  Slots for at most
+   * `max_new_nodes` new nodes are pre-allocated at the end of the node
+   * array; creating more new nodes throws `std::length_error`, and so does
+   * this method if the slots exceed the index limit of the storage.  No other
+   * method may modify the network until concurrent structural hashing is
+   * disabled again.  Until then, `size()` includes all pre-allocated slots,
+   * of which the unused ones look like CIs (both children are equal), and
+   * fanout sizes and `on_add` events do not reflect the new nodes.
+   */
+  void enable_concurrent_strash( uint64_t max_new_nodes )
+  {
+    assert( !_storage->concurrent_hash );
+    const auto num_nodes = _storage->nodes.size();
+    if ( max_new_nodes > 0u )
+    {
+      check_index( num_nodes + max_new_nodes - 1u );
+    }
+    _storage->concurrent_hash = std::make_unique<typename decltype( _storage->concurrent_hash )::element_type>( num_nodes );
+    _storage->nodes.resize( num_nodes + max_new_nodes );
+  }
+
+  /*! \brief Merges the concurrently created nodes into the network.
+   *
+   * New nodes are added to the structural hash table and to the fanout
+   * sizes of their children, and `on_add` events are triggered for them in
+   * index order.
+   */
+  void disable_concurrent_strash()
+  {
+    assert( _storage->concurrent_hash );
+    const auto first = _storage->concurrent_hash->first_new_node;
+    const auto last = _storage->concurrent_hash->size( _storage->nodes.size() );
+    _storage->concurrent_hash.reset();
+    _storage->nodes.resize( last );
+
+    for ( auto index = first; index < last; ++index )
+    {
+      auto const& n = _storage->nodes[index];
+      _storage->hash[n] = index;
+      for ( auto const& c : n.children )
+      {
+        _storage->nodes[c.index].data[0].h1++;
+      }
+      if ( _storage->fanout_index.enabled )
+      {
+        _storage->fanout_index.add_parent( index, n.children );
+      }
+    }
+
+    for ( auto index = first; index < last; ++index )
+    {
+      for ( auto const& fn : _events->on_add )
+      {
+        (*fn)( index );
+      }
+    }
+  }
+
+  bool has_concurrent_strash() const
+  {
+    return _storage->concurrent_hash != nullptr;
+  }
 #pragma endregion
 
 #pragma region Structural properties
@@ -1191,11 +1343,24 @@ public:
   }
 #pragma endregion
 
+private:
+  /* throws if a node with index `index` does not fit into the child pointers */
+  static void check_index( uint64_t index )
+  {
+    if ( index > Storage::node_type::pointer_type::max_index )
+    {
+      throw std::length_error( "the network exceeds the number of nodes of its storage" );
+    }
+  }
+
 public:
-  std::shared_ptr<xag_storage> _storage;
+  std::shared_ptr<Storage> _storage;
   std::shared_ptr<network_events<base_type>> _events;
 };
 
+using xag_network = basic_xag_network<xag_storage>;
+using compact_xag_network = basic_xag_network<compact_xag_storage>;
+
 } // namespace mockturtle
 
 namespace std
@@ -1216,4 +1381,13 @@ struct hash<mockturtle::xag_network::signal>
   }
 }; /* hash */
 
+template<>
+struct hash<mockturtle::compact_xag_network::signal>
+{
+  uint64_t operator()( mockturtle::compact_xag_network::signal const& s ) const noexcept
+  {
+    return hash<mockturtle::xag_network::signal>{}( mockturtle::xag_network::signal( s.data ) );
+  }
+}; /* hash */
+
 } // namespace std
@@ -33,6 +33,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <iostream>
@@ -40,6 +41,8 @@
 
 #include <kitty/detail/mscfix.hpp>
 
+#include "simd_kernels.hpp"
+
 namespace mockturtle
 {
 
@@ -268,23 +271,7 @@ bool cut<MaxLeaves, T>::dominates( cut const& that ) const
     return true;
   }
 
-  // this is basically
-  //     return std::includes( that.begin(), that.end(), begin(), end() )
-  // but it turns out that this code is faster compared to the standard
-  // implementation.
-  for ( auto it2 = that.begin(), it1 = begin(); it2 != that.end(); ++it2 )
-  {
-    if ( *it2 > *it1 )
-    {
-      return false;
-    }
-    if ( ( *it2 == *it1 ) && ( ++it1 == end() ) )
-    {
-      return true;
-    }
-  }
-
-  return false;
+  return simd::get_cut_kernels().leaves_subset( _leaves.data(), _length, that._leaves.data(), that._length );
 }
 
 template<int MaxLeaves, typename T>
@@ -299,11 +286,11 @@ bool cut<MaxLeaves, T>::merge( cut const& that, cut& res, uint32_t cut_size ) co
     }
   }
 
-  auto it = std::set_union( begin(), end(), that.begin(), that.end(), res.begin() );
-  if ( auto length = std::distance( res.begin(), it ); length <= cut_size )
+  const auto limit = std::min<uint32_t>( cut_size, MaxLeaves );
+  if ( const auto length = simd::get_cut_kernels().leaves_union( _leaves.data(), _length, that._leaves.data(), that._length, res._leaves.data(), limit ); length <= limit )
   {
-    res._cend = res._end = it;
-    res._length = static_cast<uint32_t>( length );
+    res._cend = res._end = res._leaves.begin() + length;
+    res._length = length;
     res._signature = _signature | that._signature;
     return true;
   }
@@ -358,6 +345,15 @@ public:
    */
   cut_set();
 
+  /*! \brief Copy constructor.
+   *
+   * The cut pointers of the copy point to its own cuts, in the same order.
+   */
+  cut_set( cut_set const& other );
+
+  /*! \brief Assignment operator. */
+  cut_set& operator=( cut_set const& other );
+
   /*! \brief Clears a cut set.
    */
   void clear();
@@ -469,6 +465,33 @@ cut_set<CutType, MaxCuts>::cut_set()
   clear();
 }
 
+template<typename CutType, int MaxCuts>
+cut_set<CutType, MaxCuts>::cut_set( cut_set const& other )
+{
+  *this = other;
+}
+
+template<typename CutType, int MaxCuts>
+cut_set<CutType, MaxCuts>& cut_set<CutType, MaxCuts>::operator=( cut_set const& other )
+{
+  if ( this != &other )
+  {
+    /* cuts behind `_pend` may have never been set */
+    for ( auto i = 0u; i < _pcuts.size(); ++i )
+    {
+      const auto offset = other._pcuts[i] - other._cuts.data();
+      _pcuts[i] = _cuts.data() + offset;
+      if ( other._pcuts.begin() + i < other._pend )
+      {
+        _cuts[offset] = other._cuts[offset];
+      }
+    }
+    _pcend = _pcuts.begin() + ( other._pcend - other._pcuts.begin() );
+    _pend = _pcuts.begin() + ( other._pend - other._pcuts.begin() );
+  }
+  return *this;
+}
+
 template<typename CutType, int MaxCuts>
 void cut_set<CutType, MaxCuts>::clear()
 {
@@ -502,8 +525,17 @@ bool cut_set<CutType, MaxCuts>::is_dominated( CutType const& cut ) const
 template<typename CutType, int MaxCuts>
 void cut_set<CutType, MaxCuts>::insert( CutType const& cut )
 {
-  /* remove elements that are dominated by new cut */
-  _pcend = _pend = std::stable_partition( _pcuts.begin(), _pend, [&cut]( auto const* other ) { return !cut.dominates( *other ); } );
+  /* remove elements that are dominated by new cut (keeps the order of the
+   * remaining cuts, like std::stable_partition, but without its buffer) */
+  auto keep = _pcuts.begin();
+  for ( auto it = _pcuts.begin(); it != _pend; ++it )
+  {
+    if ( !cut.dominates( **it ) )
+    {
+      std::iter_swap( keep++, it );
+    }
+  }
+  _pcend = _pend = keep;
 
   /* insert cut in a sorted way */
   auto ipos = std::lower_bound( _pcuts.begin(), _pend, &cut, []( auto a, auto b ) { return *a < *b; } );
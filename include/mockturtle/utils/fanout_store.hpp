@@ -0,0 +1,318 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file fanout_store.hpp
+  \brief Pooled fanout lists with constant-time removal
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/*! \brief Fanout lists of all nodes in a single pooled array.
+ *
+ * The fanouts of a node occupy a contiguous range of one array.  A range
+ * that runs full is moved to the end of the array with twice its capacity,
+ * and the array is compacted once more than half of it is unused.  Each
+ * parent keeps for each of its fanin slots the position of its entry in
+ * the fanout list of that fanin (a back-pointer), such that a parent is
+ * removed from a fanout list in constant time by swapping its entry with
+ * the last one.  Nodes are identified by their index.
+ */
+class fanout_store
+{
+public:
+  static constexpr uint32_t none = std::numeric_limits<uint32_t>::max();
+
+  struct range
+  {
+    uint32_t offset{0};
+    uint32_t size{0};
+    uint32_t capacity{0};
+  };
+
+  /* fanout list entry: parent and fanin slot of the parent */
+  struct entry
+  {
+    uint32_t parent;
+    uint32_t slot;
+  };
+
+  /* back-pointer: fanin and position in its fanout list (or `none`) */
+  struct slot
+  {
+    uint32_t fanin;
+    uint32_t position;
+  };
+
+  /*! \brief Resets the store with the given capacities for all nodes. */
+  void reset( std::vector<uint32_t> const& num_fanouts, std::vector<uint32_t> const& num_fanins )
+  {
+    assert( num_fanouts.size() == num_fanins.size() );
+    _lists.assign( num_fanouts.size(), {} );
+    _parents.assign( num_fanins.size(), {} );
+    _entries.clear();
+    _slots.clear();
+    _entries_garbage = _slots_garbage = 0u;
+
+    uint32_t offset{0};
+    for ( auto i = 0u; i < num_fanouts.size(); ++i )
+    {
+      _lists[i] = {offset, 0u, num_fanouts[i]};
+      offset += num_fanouts[i];
+    }
+    _entries.resize( offset );
+
+    offset = 0u;
+    for ( auto i = 0u; i < num_fanins.size(); ++i )
+    {
+      _parents[i] = {offset, 0u, num_fanins[i]};
+      offset += num_fanins[i];
+    }
+    _slots.resize( offset );
+  }
+
+  void resize( uint32_t num_nodes )
+  {
+    if ( num_nodes > _lists.size() )
+    {
+      _lists.resize( num_nodes );
+      _parents.resize( num_nodes );
+    }
+  }
+
+  /*! \brief Adds `p` to the fanout lists of its fanins.
+   *
+   * A fanin that occurs several times gets a single entry.
+   */
+  template<typename Fanins>
+  void add_parent( uint32_t p, Fanins const& fanins )
+  {
+    assert( _parents[p].size == 0u );
+    if ( fanins.size() > _parents[p].capacity )
+    {
+      relocate( _slots, _parents, p, static_cast<uint32_t>( fanins.size() ), _slots_garbage );
+    }
+
+    auto& r = _parents[p];
+    r.size = static_cast<uint32_t>( fanins.size() );
+    for ( auto i = 0u; i < fanins.size(); ++i )
+    {
+      const auto f = fanins[i];
+      auto position = none;
+      if ( std::find( fanins.begin(), fanins.begin() + i, f ) == fanins.begin() + i )
+      {
+        position = push_fanout( f, {p, i} );
+      }
+      _slots[r.offset + i] = {f, position};
+    }
+  }
+
+  /*! \brief Adds gate `n` of `ntk` to the fanout lists of its fanins. */
+  template<class Ntk>
+  void add_parent( Ntk const& ntk, typename Ntk::node const& n )
+  {
+    _fanins.clear();
+    ntk.foreach_fanin( n, [&]( auto const& f ) {
+      _fanins.push_back( static_cast<uint32_t>( ntk.node_to_index( ntk.get_node( f ) ) ) );
+    } );
+    add_parent( static_cast<uint32_t>( ntk.node_to_index( n ) ), _fanins );
+  }
+
+  /*! \brief Resets the store to the fanouts of all gates in `ntk`. */
+  template<class Ntk>
+  void build( Ntk const& ntk )
+  {
+    /* count first, such that no fanout list needs to grow */
+    std::vector<uint32_t> num_fanouts( ntk.size(), 0u ), num_fanins( ntk.size(), 0u );
+    ntk.foreach_gate( [&]( auto const& n ) {
+      _fanins.clear();
+      ntk.foreach_fanin( n, [&]( auto const& c ) {
+        const auto index = static_cast<uint32_t>( ntk.node_to_index( ntk.get_node( c ) ) );
+        if ( std::find( _fanins.begin(), _fanins.end(), index ) == _fanins.end() )
+        {
+          ++num_fanouts[index];
+        }
+        _fanins.push_back( index );
+      } );
+      num_fanins[ntk.node_to_index( n )] = static_cast<uint32_t>( _fanins.size() );
+    } );
+
+    reset( num_fanouts, num_fanins );
+    ntk.foreach_gate( [&]( auto const& n ) {
+      add_parent( ntk, n );
+    } );
+  }
+
+  /*! \brief Removes `p` from the fanout lists of its fanins. */
+  void remove_parent( uint32_t p )
+  {
+    auto& r = _parents[p];
+    for ( auto i = 0u; i < r.size; ++i )
+    {
+      if ( const auto s = _slots[r.offset + i]; s.position != none )
+      {
+        erase_fanout( s.fanin, s.position );
+      }
+    }
+    r.size = 0u;
+  }
+
+  /*! \brief Removes all entries from the fanout list of `n`. */
+  void clear_fanouts( uint32_t n )
+  {
+    auto& l = _lists[n];
+    for ( auto i = 0u; i < l.size; ++i )
+    {
+      const auto e = _entries[l.offset + i];
+      _slots[_parents[e.parent].offset + e.slot].position = none;
+    }
+    l.size = 0u;
+  }
+
+  entry const* begin( uint32_t n ) const
+  {
+    return _entries.data() + _lists[n].offset;
+  }
+
+  entry const* end( uint32_t n ) const
+  {
+    return _entries.data() + _lists[n].offset + _lists[n].size;
+  }
+
+  uint32_t size( uint32_t n ) const
+  {
+    return _lists[n].size;
+  }
+
+  /*! \brief Returns the number of nodes with (possibly empty) fanout lists. */
+  uint32_t num_nodes() const
+  {
+    return static_cast<uint32_t>( _lists.size() );
+  }
+
+  /*! \brief Removes all fanout lists and releases their memory. */
+  void clear()
+  {
+    std::vector<range>().swap( _lists );
+    std::vector<range>().swap( _parents );
+    std::vector<entry>().swap( _entries );
+    std::vector<slot>().swap( _slots );
+    _entries_garbage = _slots_garbage = 0u;
+  }
+
+  /*! \brief Returns the number of bytes allocated by the store. */
+  uint64_t num_bytes() const
+  {
+    return _entries.capacity() * sizeof( entry ) + _slots.capacity() * sizeof( slot ) +
+           ( _lists.capacity() + _parents.capacity() ) * sizeof( range );
+  }
+
+private:
+  uint32_t push_fanout( uint32_t n, entry const& e )
+  {
+    if ( _lists[n].size == _lists[n].capacity )
+    {
+      relocate( _entries, _lists, n, std::max( 2u, 2u * _lists[n].capacity ), _entries_garbage );
+    }
+
+    auto& l = _lists[n];
+    _entries[l.offset + l.size] = e;
+    return l.size++;
+  }
+
+  void erase_fanout( uint32_t n, uint32_t position )
+  {
+    auto& l = _lists[n];
+    assert( position < l.size );
+
+    const auto last = l.size - 1u;
+    if ( position != last )
+    {
+      const auto moved = _entries[l.offset + last];
+      _entries[l.offset + position] = moved;
+      _slots[_parents[moved.parent].offset + moved.slot].position = position;
+    }
+    l.size = last;
+  }
+
+  /* moves the elements of `ranges[n]` to the end of `pool` with a new capacity */
+  template<typename T>
+  static void relocate( std::vector<T>& pool, std::vector<range>& ranges, uint32_t n, uint32_t capacity, uint64_t& garbage )
+  {
+    if ( garbage > 1024u && 2u * garbage > pool.size() )
+    {
+      compact( pool, ranges, garbage );
+    }
+
+    auto& r = ranges[n];
+    const auto offset = static_cast<uint32_t>( pool.size() );
+    pool.resize( pool.size() + capacity );
+    std::copy( pool.begin() + r.offset, pool.begin() + r.offset + r.size, pool.begin() + offset );
+    garbage += r.capacity;
+    r.offset = offset;
+    r.capacity = capacity;
+  }
+
+  template<typename T>
+  static void compact( std::vector<T>& pool, std::vector<range>& ranges, uint64_t& garbage )
+  {
+    std::vector<T> compacted;
+    compacted.reserve( pool.size() - garbage );
+    for ( auto& r : ranges )
+    {
+      const auto offset = static_cast<uint32_t>( compacted.size() );
+      compacted.insert( compacted.end(), pool.begin() + r.offset, pool.begin() + r.offset + r.size );
+      compacted.resize( offset + r.capacity );
+      r.offset = offset;
+    }
+    pool.swap( compacted );
+    garbage = 0u;
+  }
+
+private:
+  std::vector<range> _lists;
+  std::vector<range> _parents;
+  std::vector<entry> _entries;
+  std::vector<slot> _slots;
+  uint64_t _entries_garbage{0};
+  uint64_t _slots_garbage{0};
+  std::vector<uint32_t> _fanins;
+};
+
+} // namespace detail
+
+} // namespace mockturtle
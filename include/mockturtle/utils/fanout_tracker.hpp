@@ -0,0 +1,172 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file fanout_tracker.hpp
+  \brief Fanout lists that follow network edits
+*/
+
+#pragma once
+
+#include "../networks/events.hpp"
+#include "fanout_store.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/*! \brief Fanout lists that are kept up-to-date under network events.
+ *
+ * The tracker builds a `fanout_store` for a network and registers the
+ * network events, such that the fanout lists follow created, modified, and
+ * deleted nodes.  After the fanout lists have been updated, the event is
+ * passed on to the callbacks of the owner, which can mark the transitive
+ * fanout of a node with `mark_tfo`.
+ *
+ * Copies share no events: the copy of a tracker has the same fanout lists,
+ * but does not track the network until `track` is called.
+ */
+template<class Ntk>
+class fanout_tracker
+{
+public:
+  using node = typename Ntk::node;
+
+  fanout_tracker() = default;
+
+  fanout_tracker( fanout_tracker<Ntk> const& other )
+      : _fanout( other._fanout )
+  {
+  }
+
+  fanout_tracker<Ntk>& operator=( fanout_tracker<Ntk> const& other )
+  {
+    release();
+    _fanout = other._fanout;
+    return *this;
+  }
+
+  ~fanout_tracker()
+  {
+    release();
+  }
+
+  /*! \brief Builds the fanout lists of all gates in `ntk`. */
+  void build( Ntk const& ntk )
+  {
+    _fanout.build( ntk );
+  }
+
+  /*! \brief Registers the events of `ntk`.
+   *
+   * `on_add` and `on_delete` are called with the created or deleted node,
+   * `on_modified` with the node whose fanins have changed.  Events that
+   * have been registered before are released.
+   */
+  template<typename AddFn, typename ModifiedFn, typename DeleteFn>
+  void track( Ntk const& ntk, AddFn&& on_add, ModifiedFn&& on_modified, DeleteFn&& on_delete )
+  {
+    release();
+    _ntk = &ntk;
+
+    _add_event = ntk.events().register_add_event( [this, on_add]( auto const& n ) {
+      _fanout.resize( _ntk->size() );
+      _fanout.add_parent( *_ntk, n );
+      on_add( n );
+    } );
+
+    _modified_event = ntk.events().register_modified_event( [this, on_modified]( auto const& n, auto const& previous ) {
+      (void)previous;
+      _fanout.remove_parent( _ntk->node_to_index( n ) );
+      _fanout.add_parent( *_ntk, n );
+      on_modified( n );
+    } );
+
+    _delete_event = ntk.events().register_delete_event( [this, on_delete]( auto const& n ) {
+      const auto index = _ntk->node_to_index( n );
+      _fanout.clear_fanouts( index );
+      _fanout.remove_parent( index );
+      on_delete( n );
+    } );
+  }
+
+  /*! \brief Releases the events registered by `track`. */
+  void release()
+  {
+    if ( _ntk == nullptr )
+    {
+      return;
+    }
+    _ntk->events().release_add_event( _add_event );
+    _ntk->events().release_modified_event( _modified_event );
+    _ntk->events().release_delete_event( _delete_event );
+    _ntk = nullptr;
+  }
+
+  /*! \brief Marks `n` and its transitive fanout.
+   *
+   * `mark` is called for each visited node and returns whether the node
+   * has been marked now.  The fanout of a node that was marked before is
+   * not visited again.
+   */
+  template<typename Fn>
+  void mark_tfo( node const& n, Fn&& mark )
+  {
+    _stack.push_back( n );
+    while ( !_stack.empty() )
+    {
+      const auto m = _stack.back();
+      _stack.pop_back();
+      if ( !mark( m ) )
+      {
+        continue;
+      }
+
+      const auto index = _ntk->node_to_index( m );
+      std::for_each( _fanout.begin( index ), _fanout.end( index ), [&]( auto const& e ) {
+        _stack.push_back( _ntk->index_to_node( e.parent ) );
+      } );
+    }
+  }
+
+private:
+  Ntk const* _ntk{nullptr};
+  fanout_store _fanout;
+  std::vector<node> _stack;
+
+  std::shared_ptr<typename network_events<Ntk>::add_event_type> _add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> _modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> _delete_event;
+};
+
+} // namespace detail
+
+} // namespace mockturtle
@@ -0,0 +1,429 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file mapped_patterns.hpp
+  \brief Memory-mapped binary simulation pattern files
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined( __unix__ ) || defined( __APPLE__ )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MOCKTURTLE_MAPPED_PATTERNS_MMAP
+#endif
+
+namespace mockturtle
+{
+
+/*! \brief Header of a binary simulation pattern file.
+ *
+ * A binary pattern file starts with this 64-byte header, followed by
+ * `num_pis` rows of `capacity` 64-bit words each, in native byte order.
+ * Row `i` holds the simulation values of the `i`-th primary input, with
+ * pattern `j` at bit `j % 64` of word `j / 64`.  Bits at positions
+ * `num_patterns` and above are zero, so that patterns can be appended
+ * until the capacity is exhausted.
+ */
+struct binary_patterns_header
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t num_pis;
+  uint64_t num_patterns;
+  uint64_t capacity;
+  uint64_t reserved[4];
+};
+
+static_assert( sizeof( binary_patterns_header ) == 64u, "unexpected padding in binary_patterns_header" );
+
+namespace detail
+{
+
+inline constexpr char binary_patterns_magic[8] = { 'M', 'T', 'P', 'A', 'T', 'B', 'I', 'N' };
+
+inline binary_patterns_header make_binary_patterns_header( uint32_t num_pis, uint64_t num_patterns, uint64_t capacity )
+{
+  binary_patterns_header header{};
+  std::memcpy( header.magic, binary_patterns_magic, sizeof( header.magic ) );
+  header.version = 1u;
+  header.num_pis = num_pis;
+  header.num_patterns = num_patterns;
+  header.capacity = capacity;
+  return header;
+}
+
+} // namespace detail
+
+/*! \brief Checks whether a file is a binary simulation pattern file. */
+inline bool is_binary_patterns_file( std::string const& filename )
+{
+  std::ifstream in( filename, std::ifstream::binary );
+  char magic[8];
+  if ( !in.read( magic, sizeof( magic ) ) )
+  {
+    return false;
+  }
+  return std::memcmp( magic, detail::binary_patterns_magic, sizeof( magic ) ) == 0;
+}
+
+/*! \brief Memory-mapped binary simulation pattern file.
+ *
+ * Gives direct access to the words of each primary input in a binary
+ * pattern file (see `binary_patterns_header`), without parsing or copying
+ * the file.  A file opened as writable can be extended with `add_pattern`,
+ * for instance with counter-examples found during a run; the header is
+ * updated in place and the file grows geometrically when needed.
+ *
+ * On platforms without `mmap`, the file is read into memory at once and
+ * written back by `sync` and on destruction.
+ *
+ * If a file cannot be opened or has an invalid header, `is_open` returns
+ * false.  If a writable file cannot be extended, `add_pattern` throws
+ * `std::runtime_error`; the patterns added before remain in the file.
+ *
+   \verbatim embed:rst
+
+   Example
+
+   .. code-block:: c++
+
+      mapped_patterns cex( "cex.bin", aig.num_pis() ); // create a new file
+      cex.add_pattern( { true, false, true } );
+
+      mapped_patterns saved( "patterns.bin" ); // open read-only
+      uint64_t const* words = saved.words( 0u );
+   \endverbatim
+ */
+class mapped_patterns
+{
+public:
+  /*! \brief Opens an existing binary pattern file.
+   *
+   * \param filename Name of the binary pattern file.
+   * \param writable Allows to append patterns to the file.
+   */
+  explicit mapped_patterns( std::string const& filename, bool writable = false )
+      : _filename( filename ), _writable( writable )
+  {
+    if ( !open() )
+    {
+      close();
+    }
+  }
+
+  /*! \brief Creates a new binary pattern file without patterns.
+   *
+   * An existing file with the same name is overwritten.  The file is
+   * opened as writable.
+   *
+   * \param filename Name of the binary pattern file.
+   * \param num_pis Number of primary inputs.
+   * \param capacity Initial number of patterns that fit in the file.
+   */
+  mapped_patterns( std::string const& filename, uint32_t num_pis, uint64_t capacity = 64u )
+      : _filename( filename ), _writable( true )
+  {
+    const auto header = detail::make_binary_patterns_header( num_pis, 0u, std::max<uint64_t>( 1u, ( capacity + 63u ) >> 6 ) );
+    {
+      std::ofstream out( filename, std::ofstream::binary | std::ofstream::trunc );
+      out.write( reinterpret_cast<char const*>( &header ), sizeof( header ) );
+      const std::vector<uint64_t> zeros( header.capacity, 0u );
+      for ( auto i = 0u; i < num_pis; ++i )
+      {
+        out.write( reinterpret_cast<char const*>( zeros.data() ), zeros.size() * sizeof( uint64_t ) );
+      }
+    }
+    if ( !open() )
+    {
+      close();
+    }
+  }
+
+  mapped_patterns( mapped_patterns const& ) = delete;
+  mapped_patterns& operator=( mapped_patterns const& ) = delete;
+
+  ~mapped_patterns()
+  {
+    close();
+  }
+
+  /*! \brief Returns true if the file was opened successfully. */
+  bool is_open() const
+  {
+    return _header != nullptr;
+  }
+
+  /*! \brief Returns true if patterns can be appended. */
+  bool is_writable() const
+  {
+    return _writable;
+  }
+
+  /*! \brief Number of primary inputs. */
+  uint32_t num_pis() const
+  {
+    return _header->num_pis;
+  }
+
+  /*! \brief Number of patterns in the file. */
+  uint64_t num_patterns() const
+  {
+    return _header->num_patterns;
+  }
+
+  /*! \brief Number of patterns that fit in the file without growing it. */
+  uint64_t capacity() const
+  {
+    return _header->capacity << 6;
+  }
+
+  /*! \brief Returns the simulation words of a primary input.
+   *
+   * The pointer holds `(num_patterns() + 63) / 64` valid words and is
+   * invalidated when the file grows in `add_pattern`.
+   */
+  uint64_t const* words( uint32_t index ) const
+  {
+    assert( index < num_pis() );
+    return data() + index * _header->capacity;
+  }
+
+  /*! \brief Appends a pattern (primary input assignment) to the file.
+   *
+   * \param pattern The pattern. Length should be the same as number of PIs.
+   */
+  void add_pattern( std::vector<bool> const& pattern )
+  {
+    assert( _writable );
+    assert( pattern.size() == num_pis() );
+
+    if ( _header->num_patterns == capacity() )
+    {
+      grow();
+    }
+
+    const auto p = _header->num_patterns;
+    const auto word = p >> 6;
+    const auto mask = uint64_t( 1 ) << ( p & 63u );
+    auto* rows = data();
+    for ( auto i = 0u; i < pattern.size(); ++i )
+    {
+      if ( pattern[i] )
+      {
+        rows[i * _header->capacity + word] |= mask;
+      }
+    }
+    ++_header->num_patterns;
+  }
+
+  /*! \brief Writes pending changes to the file. */
+  void sync()
+  {
+    if ( !_writable || _header == nullptr )
+    {
+      return;
+    }
+#ifdef MOCKTURTLE_MAPPED_PATTERNS_MMAP
+    msync( _memory, _size, MS_SYNC );
+#else
+    std::ofstream out( _filename, std::ofstream::binary | std::ofstream::trunc );
+    out.write( reinterpret_cast<char const*>( _buffer.data() ), _size );
+#endif
+  }
+
+private:
+  uint64_t* data() const
+  {
+    return reinterpret_cast<uint64_t*>( reinterpret_cast<char*>( _header ) + sizeof( binary_patterns_header ) );
+  }
+
+  uint64_t file_size( binary_patterns_header const& header ) const
+  {
+    return sizeof( binary_patterns_header ) + uint64_t( header.num_pis ) * header.capacity * sizeof( uint64_t );
+  }
+
+  bool valid_header( uint64_t size ) const
+  {
+    return size >= sizeof( binary_patterns_header ) &&
+           std::memcmp( _header->magic, detail::binary_patterns_magic, sizeof( _header->magic ) ) == 0 &&
+           _header->version == 1u &&
+           ( _header->num_patterns + 63u ) >> 6 <= _header->capacity &&
+           file_size( *_header ) <= size;
+  }
+
+#ifdef MOCKTURTLE_MAPPED_PATTERNS_MMAP
+  bool map( uint64_t size )
+  {
+    void* memory = mmap( nullptr, size, _writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, _fd, 0 );
+    if ( memory == MAP_FAILED )
+    {
+      return false;
+    }
+    _memory = memory;
+    _size = size;
+    _header = static_cast<binary_patterns_header*>( memory );
+    return true;
+  }
+
+  void unmap()
+  {
+    if ( _memory != nullptr )
+    {
+      munmap( _memory, _size );
+    }
+    _memory = nullptr;
+    _header = nullptr;
+  }
+
+  bool open()
+  {
+    _fd = ::open( _filename.c_str(), _writable ? O_RDWR : O_RDONLY );
+    if ( _fd < 0 )
+    {
+      return false;
+    }
+    struct stat st;
+    if ( fstat( _fd, &st ) != 0 || uint64_t( st.st_size ) < sizeof( binary_patterns_header ) )
+    {
+      return false;
+    }
+    return map( st.st_size ) && valid_header( st.st_size );
+  }
+
+  void close()
+  {
+    sync();
+    unmap();
+    if ( _fd >= 0 )
+    {
+      ::close( _fd );
+    }
+    _fd = -1;
+  }
+
+  void grow()
+  {
+    const auto old_capacity = _header->capacity;
+    const auto new_capacity = 2u * old_capacity;
+    const auto num_pis = _header->num_pis;
+
+    auto header = *_header;
+    header.capacity = new_capacity;
+    const auto new_size = file_size( header );
+
+    /* the old mapping stays valid if the file cannot be extended */
+    if ( ftruncate( _fd, new_size ) != 0 )
+    {
+      throw std::runtime_error( "cannot grow binary pattern file " + _filename );
+    }
+    unmap();
+    if ( !map( new_size ) )
+    {
+      throw std::runtime_error( "cannot map binary pattern file " + _filename );
+    }
+    move_rows( num_pis, old_capacity, new_capacity );
+  }
+#else
+  bool open()
+  {
+    std::ifstream in( _filename, std::ifstream::binary | std::ifstream::ate );
+    if ( !in )
+    {
+      return false;
+    }
+    const uint64_t size = in.tellg();
+    if ( size < sizeof( binary_patterns_header ) )
+    {
+      return false;
+    }
+    _buffer.resize( ( size + 7u ) >> 3 );
+    in.seekg( 0 );
+    in.read( reinterpret_cast<char*>( _buffer.data() ), size );
+    _size = size;
+    _header = reinterpret_cast<binary_patterns_header*>( _buffer.data() );
+    return valid_header( size );
+  }
+
+  void close()
+  {
+    sync();
+    _buffer.clear();
+    _header = nullptr;
+  }
+
+  void grow()
+  {
+    const auto old_capacity = _header->capacity;
+    const auto new_capacity = 2u * old_capacity;
+    const auto num_pis = _header->num_pis;
+
+    auto header = *_header;
+    header.capacity = new_capacity;
+    _size = file_size( header );
+    _buffer.resize( _size >> 3 );
+    _header = reinterpret_cast<binary_patterns_header*>( _buffer.data() );
+    move_rows( num_pis, old_capacity, new_capacity );
+  }
+#endif
+
+  /* moves the rows to their positions for a larger capacity, starting from the last one */
+  void move_rows( uint32_t num_pis, uint64_t old_capacity, uint64_t new_capacity )
+  {
+    auto* rows = data();
+    for ( auto i = num_pis; i-- > 0u; )
+    {
+      std::memmove( rows + i * new_capacity, rows + i * old_capacity, old_capacity * sizeof( uint64_t ) );
+      std::fill( rows + i * new_capacity + old_capacity, rows + ( i + 1 ) * new_capacity, uint64_t( 0 ) );
+    }
+    _header->capacity = new_capacity;
+  }
+
+private:
+  std::string _filename;
+  bool _writable;
+  binary_patterns_header* _header{nullptr};
+  uint64_t _size{0u};
+#ifdef MOCKTURTLE_MAPPED_PATTERNS_MMAP
+  int _fd{-1};
+  void* _memory{nullptr};
+#else
+  std::vector<uint64_t> _buffer;
+#endif
+};
+
+} // namespace mockturtle
@@ -0,0 +1,520 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file simd_kernels.hpp
+  \brief Word-parallel kernels for simulating gates on bit vectors and
+         for merging cuts
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if ( defined( __GNUC__ ) || defined( __clang__ ) ) && ( defined( __x86_64__ ) || defined( __i386__ ) )
+#define MOCKTURTLE_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace mockturtle
+{
+
+namespace simd
+{
+
+/*! \brief Instruction sets for which kernels are implemented. */
+enum class instruction_set
+{
+  scalar,
+  avx2,
+  avx512
+};
+
+/*! \brief Gate kernels over arrays of 64-bit words.
+ *
+ * Each kernel writes `num_words` words into `out`.  Every operand comes
+ * with a mask, which is either 0 or all ones, and is XOR-ed to the
+ * operand to complement it.  `out` may alias an operand.
+ */
+struct kernels
+{
+  void ( *and2 )( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, std::size_t num_words );
+  void ( *xor2 )( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, std::size_t num_words );
+  void ( *maj3 )( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, uint64_t const* c, uint64_t mc, std::size_t num_words );
+  void ( *xor3 )( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, uint64_t const* c, uint64_t mc, std::size_t num_words );
+};
+
+namespace detail
+{
+
+inline void and2_scalar( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, std::size_t num_words )
+{
+  for ( std::size_t i = 0; i < num_words; ++i )
+  {
+    out[i] = ( a[i] ^ ma ) & ( b[i] ^ mb );
+  }
+}
+
+inline void xor2_scalar( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, std::size_t num_words )
+{
+  for ( std::size_t i = 0; i < num_words; ++i )
+  {
+    out[i] = ( a[i] ^ ma ) ^ ( b[i] ^ mb );
+  }
+}
+
+inline void maj3_scalar( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, uint64_t const* c, uint64_t mc, std::size_t num_words )
+{
+  for ( std::size_t i = 0; i < num_words; ++i )
+  {
+    const auto x = a[i] ^ ma, y = b[i] ^ mb, z = c[i] ^ mc;
+    out[i] = ( x & y ) | ( z & ( x | y ) );
+  }
+}
+
+inline void xor3_scalar( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, uint64_t const* c, uint64_t mc, std::size_t num_words )
+{
+  for ( std::size_t i = 0; i < num_words; ++i )
+  {
+    out[i] = a[i] ^ b[i] ^ c[i] ^ ma ^ mb ^ mc;
+  }
+}
+
+#ifdef MOCKTURTLE_SIMD_X86
+/* the vector loops leave the remaining words to the scalar kernels */
+
+__attribute__( ( target( "avx2" ) ) ) inline void and2_avx2( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, std::size_t num_words )
+{
+  const auto va = _mm256_set1_epi64x( static_cast<long long>( ma ) ), vb = _mm256_set1_epi64x( static_cast<long long>( mb ) );
+  std::size_t i = 0;
+  for ( ; i + 4 <= num_words; i += 4 )
+  {
+    const auto x = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + i ) ), va );
+    const auto y = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + i ) ), vb );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + i ), _mm256_and_si256( x, y ) );
+  }
+  and2_scalar( out + i, a + i, ma, b + i, mb, num_words - i );
+}
+
+__attribute__( ( target( "avx2" ) ) ) inline void xor2_avx2( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, std::size_t num_words )
+{
+  const auto m = _mm256_set1_epi64x( static_cast<long long>( ma ^ mb ) );
+  std::size_t i = 0;
+  for ( ; i + 4 <= num_words; i += 4 )
+  {
+    const auto x = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + i ) );
+    const auto y = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + i ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + i ), _mm256_xor_si256( _mm256_xor_si256( x, y ), m ) );
+  }
+  xor2_scalar( out + i, a + i, ma, b + i, mb, num_words - i );
+}
+
+__attribute__( ( target( "avx2" ) ) ) inline void maj3_avx2( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, uint64_t const* c, uint64_t mc, std::size_t num_words )
+{
+  const auto va = _mm256_set1_epi64x( static_cast<long long>( ma ) );
+  const auto vb = _mm256_set1_epi64x( static_cast<long long>( mb ) );
+  const auto vc = _mm256_set1_epi64x( static_cast<long long>( mc ) );
+  std::size_t i = 0;
+  for ( ; i + 4 <= num_words; i += 4 )
+  {
+    const auto x = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + i ) ), va );
+    const auto y = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + i ) ), vb );
+    const auto z = _mm256_xor_si256( _mm256_loadu_si256( reinterpret_cast<__m256i const*>( c + i ) ), vc );
+    const auto r = _mm256_or_si256( _mm256_and_si256( x, y ), _mm256_and_si256( z, _mm256_or_si256( x, y ) ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + i ), r );
+  }
+  maj3_scalar( out + i, a + i, ma, b + i, mb, c + i, mc, num_words - i );
+}
+
+__attribute__( ( target( "avx2" ) ) ) inline void xor3_avx2( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, uint64_t const* c, uint64_t mc, std::size_t num_words )
+{
+  const auto m = _mm256_set1_epi64x( static_cast<long long>( ma ^ mb ^ mc ) );
+  std::size_t i = 0;
+  for ( ; i + 4 <= num_words; i += 4 )
+  {
+    const auto x = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( a + i ) );
+    const auto y = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( b + i ) );
+    const auto z = _mm256_loadu_si256( reinterpret_cast<__m256i const*>( c + i ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + i ), _mm256_xor_si256( _mm256_xor_si256( x, y ), _mm256_xor_si256( z, m ) ) );
+  }
+  xor3_scalar( out + i, a + i, ma, b + i, mb, c + i, mc, num_words - i );
+}
+
+__attribute__( ( target( "avx512f" ) ) ) inline void and2_avx512( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, std::size_t num_words )
+{
+  const auto va = _mm512_set1_epi64( static_cast<long long>( ma ) ), vb = _mm512_set1_epi64( static_cast<long long>( mb ) );
+  std::size_t i = 0;
+  for ( ; i + 8 <= num_words; i += 8 )
+  {
+    const auto x = _mm512_xor_si512( _mm512_loadu_si512( a + i ), va );
+    const auto y = _mm512_xor_si512( _mm512_loadu_si512( b + i ), vb );
+    _mm512_storeu_si512( out + i, _mm512_and_si512( x, y ) );
+  }
+  and2_scalar( out + i, a + i, ma, b + i, mb, num_words - i );
+}
+
+__attribute__( ( target( "avx512f" ) ) ) inline void xor2_avx512( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, std::size_t num_words )
+{
+  const auto m = _mm512_set1_epi64( static_cast<long long>( ma ^ mb ) );
+  std::size_t i = 0;
+  for ( ; i + 8 <= num_words; i += 8 )
+  {
+    /* 0x96 is the truth table of a three-input XOR */
+    const auto r = _mm512_ternarylogic_epi64( _mm512_loadu_si512( a + i ), _mm512_loadu_si512( b + i ), m, 0x96 );
+    _mm512_storeu_si512( out + i, r );
+  }
+  xor2_scalar( out + i, a + i, ma, b + i, mb, num_words - i );
+}
+
+__attribute__( ( target( "avx512f" ) ) ) inline void maj3_avx512( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, uint64_t const* c, uint64_t mc, std::size_t num_words )
+{
+  const auto va = _mm512_set1_epi64( static_cast<long long>( ma ) );
+  const auto vb = _mm512_set1_epi64( static_cast<long long>( mb ) );
+  const auto vc = _mm512_set1_epi64( static_cast<long long>( mc ) );
+  std::size_t i = 0;
+  for ( ; i + 8 <= num_words; i += 8 )
+  {
+    const auto x = _mm512_xor_si512( _mm512_loadu_si512( a + i ), va );
+    const auto y = _mm512_xor_si512( _mm512_loadu_si512( b + i ), vb );
+    const auto z = _mm512_xor_si512( _mm512_loadu_si512( c + i ), vc );
+    /* 0xe8 is the truth table of a three-input majority */
+    _mm512_storeu_si512( out + i, _mm512_ternarylogic_epi64( x, y, z, 0xe8 ) );
+  }
+  maj3_scalar( out + i, a + i, ma, b + i, mb, c + i, mc, num_words - i );
+}
+
+__attribute__( ( target( "avx512f" ) ) ) inline void xor3_avx512( uint64_t* out, uint64_t const* a, uint64_t ma, uint64_t const* b, uint64_t mb, uint64_t const* c, uint64_t mc, std::size_t num_words )
+{
+  const auto m = _mm512_set1_epi64( static_cast<long long>( ma ^ mb ^ mc ) );
+  std::size_t i = 0;
+  for ( ; i + 8 <= num_words; i += 8 )
+  {
+    const auto x = _mm512_ternarylogic_epi64( _mm512_loadu_si512( a + i ), _mm512_loadu_si512( b + i ), _mm512_loadu_si512( c + i ), 0x96 );
+    _mm512_storeu_si512( out + i, _mm512_xor_si512( x, m ) );
+  }
+  xor3_scalar( out + i, a + i, ma, b + i, mb, c + i, mc, num_words - i );
+}
+#endif
+
+} // namespace detail
+
+/*! \brief Returns the widest instruction set supported by the running CPU. */
+inline instruction_set detect_instruction_set()
+{
+#ifdef MOCKTURTLE_SIMD_X86
+  __builtin_cpu_init();
+  if ( __builtin_cpu_supports( "avx512f" ) )
+  {
+    return instruction_set::avx512;
+  }
+  if ( __builtin_cpu_supports( "avx2" ) )
+  {
+    return instruction_set::avx2;
+  }
+#endif
+  return instruction_set::scalar;
+}
+
+/*! \brief Returns the kernels for an instruction set.
+ *
+ * The caller must make sure that the CPU supports the instruction set.
+ * Kernels for instruction sets that are not available on the target
+ * architecture fall back to the scalar ones.
+ */
+inline kernels const& get_kernels( instruction_set isa )
+{
+  static constexpr kernels scalar{&detail::and2_scalar, &detail::xor2_scalar, &detail::maj3_scalar, &detail::xor3_scalar};
+#ifdef MOCKTURTLE_SIMD_X86
+  static constexpr kernels avx2{&detail::and2_avx2, &detail::xor2_avx2, &detail::maj3_avx2, &detail::xor3_avx2};
+  static constexpr kernels avx512{&detail::and2_avx512, &detail::xor2_avx512, &detail::maj3_avx512, &detail::xor3_avx512};
+
+  switch ( isa )
+  {
+  case instruction_set::avx512:
+    return avx512;
+  case instruction_set::avx2:
+    return avx2;
+  default:
+    break;
+  }
+#else
+  (void)isa;
+#endif
+  return scalar;
+}
+
+/*! \brief Returns the kernels for the running CPU (detected once). */
+inline kernels const& get_kernels()
+{
+  static kernels const& best = get_kernels( detect_instruction_set() );
+  return best;
+}
+
+/*! \brief Kernels for sorted leaf sets of cuts.
+ *
+ * Leaf sets are sorted arrays of 32-bit node indexes.  The vector kernels
+ * only read the first `na` and `nb` entries with masked loads, and fall
+ * back to the scalar kernels for sets that do not fit into their registers.
+ */
+struct cut_kernels
+{
+  /*! \brief Checks whether `a` is a subset of `b` (requires `na <= nb`). */
+  bool ( *leaves_subset )( uint32_t const* a, uint32_t na, uint32_t const* b, uint32_t nb );
+
+  /*! \brief Writes the union of `a` and `b` into `out`.
+   *
+   * Returns the size of the union, if it is at most `limit`, otherwise a
+   * value larger than `limit`, in which case the contents of `out` are
+   * unspecified.  `out` must hold `limit` entries and must not alias `a`
+   * or `b`.
+   */
+  uint32_t ( *leaves_union )( uint32_t const* a, uint32_t na, uint32_t const* b, uint32_t nb, uint32_t* out, uint32_t limit );
+};
+
+namespace detail
+{
+
+inline bool leaves_subset_scalar( uint32_t const* a, uint32_t na, uint32_t const* b, uint32_t nb )
+{
+  if ( na == 0u )
+  {
+    return true;
+  }
+
+  for ( uint32_t i = 0u, j = 0u; j < nb; ++j )
+  {
+    if ( b[j] > a[i] )
+    {
+      return false;
+    }
+    if ( b[j] == a[i] && ++i == na )
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+inline uint32_t leaves_union_scalar( uint32_t const* a, uint32_t na, uint32_t const* b, uint32_t nb, uint32_t* out, uint32_t limit )
+{
+  uint32_t i{0u}, j{0u}, k{0u};
+  while ( i < na || j < nb )
+  {
+    if ( k == limit )
+    {
+      return limit + 1u;
+    }
+    if ( j == nb || ( i < na && a[i] < b[j] ) )
+    {
+      out[k++] = a[i++];
+    }
+    else
+    {
+      i += ( i < na && a[i] == b[j] ) ? 1u : 0u;
+      out[k++] = b[j++];
+    }
+  }
+  return k;
+}
+
+#ifdef MOCKTURTLE_SIMD_X86
+/* The union kernels merge two sets of at most 8 leaves with a bitonic
+ * merging network: `a` (padded with ones) followed by the reversed `b` is a
+ * bitonic sequence of 16 lanes, which is sorted in 4 min/max layers.
+ * Duplicates are adjacent afterwards, and the padding is at the end. */
+
+__attribute__( ( target( "avx2" ) ) ) inline __m256i load_leaves_avx2( uint32_t const* p, int32_t n )
+{
+  const auto mask = _mm256_cmpgt_epi32( _mm256_set1_epi32( n ), _mm256_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7 ) );
+  return _mm256_or_si256( _mm256_maskload_epi32( reinterpret_cast<int const*>( p ), mask ), _mm256_xor_si256( mask, _mm256_set1_epi32( -1 ) ) );
+}
+
+__attribute__( ( target( "avx2" ) ) ) inline bool leaves_subset_avx2( uint32_t const* a, uint32_t na, uint32_t const* b, uint32_t nb )
+{
+  if ( nb > 16u )
+  {
+    return leaves_subset_scalar( a, na, b, nb );
+  }
+
+  /* padding lanes hold ones, which are no node indexes */
+  const auto lo = load_leaves_avx2( b, static_cast<int32_t>( nb ) );
+  const auto hi = load_leaves_avx2( b + 8, static_cast<int32_t>( nb ) - 8 );
+  for ( auto i = 0u; i < na; ++i )
+  {
+    const auto x = _mm256_set1_epi32( static_cast<int32_t>( a[i] ) );
+    if ( _mm256_testz_si256( _mm256_or_si256( _mm256_cmpeq_epi32( x, lo ), _mm256_cmpeq_epi32( x, hi ) ), _mm256_set1_epi32( -1 ) ) )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+__attribute__( ( target( "avx2" ) ) ) inline __m256i bitonic_merge8_avx2( __m256i v )
+{
+  auto s = _mm256_permute2x128_si256( v, v, 1 );
+  v = _mm256_blend_epi32( _mm256_min_epu32( v, s ), _mm256_max_epu32( v, s ), 0xf0 );
+  s = _mm256_shuffle_epi32( v, _MM_SHUFFLE( 1, 0, 3, 2 ) );
+  v = _mm256_blend_epi32( _mm256_min_epu32( v, s ), _mm256_max_epu32( v, s ), 0xcc );
+  s = _mm256_shuffle_epi32( v, _MM_SHUFFLE( 2, 3, 0, 1 ) );
+  return _mm256_blend_epi32( _mm256_min_epu32( v, s ), _mm256_max_epu32( v, s ), 0xaa );
+}
+
+__attribute__( ( target( "avx2" ) ) ) inline uint32_t leaves_union_avx2( uint32_t const* a, uint32_t na, uint32_t const* b, uint32_t nb, uint32_t* out, uint32_t limit )
+{
+  if ( na > 8u || nb > 8u )
+  {
+    return leaves_union_scalar( a, na, b, nb, out, limit );
+  }
+
+  const auto x = load_leaves_avx2( a, static_cast<int32_t>( na ) );
+  const auto y = _mm256_permutevar8x32_epi32( load_leaves_avx2( b, static_cast<int32_t>( nb ) ), _mm256_setr_epi32( 7, 6, 5, 4, 3, 2, 1, 0 ) );
+
+  alignas( 32 ) uint32_t sorted[17];
+  _mm256_store_si256( reinterpret_cast<__m256i*>( sorted ), bitonic_merge8_avx2( _mm256_min_epu32( x, y ) ) );
+  _mm256_store_si256( reinterpret_cast<__m256i*>( sorted + 8 ), bitonic_merge8_avx2( _mm256_max_epu32( x, y ) ) );
+
+  /* remove duplicates and padding */
+  uint32_t k{0u}, last{~sorted[0]};
+  for ( auto i = 0u; i < na + nb; ++i )
+  {
+    k += sorted[i] != last ? 1u : 0u;
+    last = sorted[i];
+  }
+  if ( k > limit )
+  {
+    return k;
+  }
+  k = 0u;
+  last = ~sorted[0];
+  for ( auto i = 0u; i < na + nb; ++i )
+  {
+    if ( sorted[i] != last )
+    {
+      out[k++] = last = sorted[i];
+    }
+  }
+  return k;
+}
+
+__attribute__( ( target( "avx512f" ) ) ) inline bool leaves_subset_avx512( uint32_t const* a, uint32_t na, uint32_t const* b, uint32_t nb )
+{
+  if ( nb > 16u )
+  {
+    return leaves_subset_scalar( a, na, b, nb );
+  }
+
+  const __mmask16 mb = static_cast<__mmask16>( ( 1u << nb ) - 1u );
+  const auto vb = _mm512_maskz_loadu_epi32( mb, b );
+  for ( auto i = 0u; i < na; ++i )
+  {
+    if ( !_mm512_mask_cmpeq_epi32_mask( mb, _mm512_set1_epi32( static_cast<int32_t>( a[i] ) ), vb ) )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* GCC warns about the undefined pass-through operand of unmasked AVX-512 intrinsics */
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+__attribute__( ( target( "avx512f" ) ) ) inline uint32_t leaves_union_avx512( uint32_t const* a, uint32_t na, uint32_t const* b, uint32_t nb, uint32_t* out, uint32_t limit )
+{
+  if ( na > 8u || nb > 8u )
+  {
+    return leaves_union_scalar( a, na, b, nb, out, limit );
+  }
+
+  const auto ones = _mm512_set1_epi32( -1 );
+  auto v = _mm512_mask_loadu_epi32( ones, static_cast<__mmask16>( ( 1u << na ) - 1u ), a );
+  const auto vb = _mm512_mask_loadu_epi32( ones, static_cast<__mmask16>( ( 1u << nb ) - 1u ), b );
+  v = _mm512_mask_permutexvar_epi32( v, 0xff00, _mm512_setr_epi32( 0, 0, 0, 0, 0, 0, 0, 0, 7, 6, 5, 4, 3, 2, 1, 0 ), vb );
+
+  /* bitonic merge, lanes with bit d set take the maximum */
+  const auto lanes = _mm512_setr_epi32( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+  for ( int32_t d = 8; d > 0; d >>= 1 )
+  {
+    const auto s = _mm512_permutexvar_epi32( _mm512_xor_si512( lanes, _mm512_set1_epi32( d ) ), v );
+    const auto upper = _mm512_test_epi32_mask( lanes, _mm512_set1_epi32( d ) );
+    v = _mm512_mask_blend_epi32( upper, _mm512_min_epu32( v, s ), _mm512_max_epu32( v, s ) );
+  }
+
+  /* keep the first lane of each run of equal leaves, except the padding */
+  const auto prev = _mm512_permutexvar_epi32( _mm512_setr_epi32( 0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14 ), v );
+  const __mmask16 keep = ( _mm512_cmpneq_epu32_mask( v, prev ) | 1u ) & _mm512_cmpneq_epu32_mask( v, ones );
+  const auto k = static_cast<uint32_t>( __builtin_popcount( keep ) );
+  if ( k <= limit )
+  {
+    _mm512_mask_compressstoreu_epi32( out, keep, v );
+  }
+  return k;
+}
+#if defined( __GNUC__ ) && !defined( __clang__ )
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+} // namespace detail
+
+/*! \brief Returns the cut kernels for an instruction set.
+ *
+ * The caller must make sure that the CPU supports the instruction set.
+ */
+inline cut_kernels const& get_cut_kernels( instruction_set isa )
+{
+  static constexpr cut_kernels scalar{&detail::leaves_subset_scalar, &detail::leaves_union_scalar};
+#ifdef MOCKTURTLE_SIMD_X86
+  static constexpr cut_kernels avx2{&detail::leaves_subset_avx2, &detail::leaves_union_avx2};
+  static constexpr cut_kernels avx512{&detail::leaves_subset_avx512, &detail::leaves_union_avx512};
+
+  switch ( isa )
+  {
+  case instruction_set::avx512:
+    return avx512;
+  case instruction_set::avx2:
+    return avx2;
+  default:
+    break;
+  }
+#else
+  (void)isa;
+#endif
+  return scalar;
+}
+
+/*! \brief Returns the cut kernels for the running CPU (detected once). */
+inline cut_kernels const& get_cut_kernels()
+{
+  static cut_kernels const& best = get_cut_kernels( detect_instruction_set() );
+  return best;
+}
+
+} // namespace simd
+
+} // namespace mockturtle
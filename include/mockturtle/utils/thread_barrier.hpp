@@ -0,0 +1,78 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file thread_barrier.hpp
+  \brief Reusable barrier for a fixed number of threads
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+
+namespace mockturtle
+{
+
+namespace detail
+{
+
+/* reusable barrier for a fixed number of threads */
+class thread_barrier
+{
+public:
+  explicit thread_barrier( uint32_t num_threads )
+      : _num_threads( num_threads )
+  {
+  }
+
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock( _mutex );
+    const auto generation = _generation;
+    if ( ++_num_waiting == _num_threads )
+    {
+      _num_waiting = 0u;
+      ++_generation;
+      _cv.notify_all();
+    }
+    else
+    {
+      _cv.wait( lock, [&]() { return _generation != generation; } );
+    }
+  }
+
+private:
+  uint32_t _num_threads;
+  uint32_t _num_waiting{0u};
+  uint64_t _generation{0u};
+  std::mutex _mutex;
+  std::condition_variable _cv;
+};
+
+} // namespace detail
+
+} // namespace mockturtle
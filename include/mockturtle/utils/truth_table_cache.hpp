@@ -33,12 +33,14 @@
 
 #pragma once
 
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 
 #include <kitty/hash.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
+#include <kitty/static_truth_table.hpp>
 
 namespace mockturtle
 {
@@ -154,4 +156,101 @@ TT truth_table_cache<TT>::operator[]( uint32_t index ) const
   return ( index & 1 ) ? ~entry : entry;
 }
 
+
+/*! \brief Truth table cache for static truth tables with up to 6 variables.
+ *
+ * Same interface and literals as the generic cache.  Since the truth tables
+ * fit into one word, they are stored in a flat hash table with linear
+ * probing, which holds indexes into the array of truth tables.  Inserting
+ * does not allocate memory, unless one of the arrays grows.
+ */
+template<uint32_t NumVars>
+class truth_table_cache<kitty::static_truth_table<NumVars, true>>
+{
+public:
+  using truth_table_t = kitty::static_truth_table<NumVars, true>;
+
+  /*! \brief Creates a truth table cache and reserves memory. */
+  truth_table_cache( uint32_t capacity = 1000u )
+  {
+    _data.reserve( capacity );
+    rehash( 2u * capacity );
+  }
+
+  /*! \brief Inserts a truth table and returns a literal. */
+  uint32_t insert( truth_table_t tt )
+  {
+    uint32_t is_compl{0};
+
+    if ( kitty::get_bit( tt, 0 ) )
+    {
+      is_compl = 1;
+      tt = ~tt;
+    }
+
+    auto slot = find( tt._bits );
+    if ( _slots[slot] != 0u )
+    {
+      return 2u * ( _slots[slot] - 1u ) + is_compl;
+    }
+
+    /* add truth table to end of cache, keep the load factor below 1/2 */
+    const auto size = static_cast<uint32_t>( _data.size() );
+    _data.push_back( tt );
+    if ( 2u * _data.size() > _slots.size() )
+    {
+      rehash( 2u * static_cast<uint32_t>( _slots.size() ) );
+    }
+    else
+    {
+      _slots[slot] = size + 1u;
+    }
+    return 2u * size + is_compl;
+  }
+
+  /*! \brief Returns truth table for a given literal. */
+  truth_table_t operator[]( uint32_t lit ) const
+  {
+    auto const& entry = _data[lit >> 1];
+    return ( lit & 1 ) ? ~entry : entry;
+  }
+
+  /*! \brief Returns number of normalized truth tables in the cache. */
+  auto size() const { return _data.size(); }
+
+private:
+  /* slot of `word`, or the empty slot at which it would be inserted */
+  std::size_t find( uint64_t word ) const
+  {
+    const auto mask = _slots.size() - 1u;
+    for ( auto slot = static_cast<std::size_t>( ( word * UINT64_C( 0x9e3779b97f4a7c15 ) ) >> 32 ) & mask;; slot = ( slot + 1u ) & mask )
+    {
+      if ( _slots[slot] == 0u || _data[_slots[slot] - 1u]._bits == word )
+      {
+        return slot;
+      }
+    }
+  }
+
+  void rehash( uint32_t min_slots )
+  {
+    std::size_t num_slots{16u};
+    while ( num_slots < min_slots )
+    {
+      num_slots <<= 1;
+    }
+
+    _slots.assign( num_slots, 0u );
+    for ( auto i = 0u; i < _data.size(); ++i )
+    {
+      _slots[find( _data[i]._bits )] = i + 1u;
+    }
+  }
+
+private:
+  /* index + 1 into `_data` (0 for empty slots), size is a power of 2 */
+  std::vector<uint32_t> _slots;
+  std::vector<truth_table_t> _data;
+};
+
 } /* namespace mockturtle */
\ No newline at end of file
@@ -37,6 +37,7 @@
 #include "../utils/cost_functions.hpp"
 #include "../utils/node_map.hpp"
 #include "../networks/events.hpp"
+#include "fanout_view.hpp"
 #include "immutable_view.hpp"
 
 #include <cstdint>
@@ -52,6 +53,10 @@ struct depth_view_params
 
   /*! \brief Whether PIs have costs. */
   bool pi_cost{false};
+
+  /*! \brief Keep levels, depth, and critical paths up-to-date when nodes
+   *         are modified or deleted. */
+  bool incremental{false};
 };
 
 /*! \brief Implements `depth` and `level` methods for networks.
@@ -67,6 +72,14 @@ struct depth_view_params
  * recalculated (due to efficiency reasons).  In order to recalculate levels,
  * depth, and critical paths, one can call `update_levels` instead.
  *
+ * If `incremental` is set in the parameters, the view also keeps the fanouts
+ * of all nodes and reacts to modified and deleted nodes.  The levels of a
+ * modified node and of its transitive fanout are updated in the order of
+ * their previous levels, and the propagation stops at nodes whose level
+ * does not change.  Depth and critical paths are recomputed from the POs on
+ * the next query after a change, and `update_levels` does not recompute the
+ * levels unless they have been overwritten with `set_level`.
+ *
  * **Required network functions:**
  * - `size`
  * - `get_node`
@@ -120,6 +133,7 @@ public:
     , _levels( *this )
     , _crit_path( *this )
     , _cost_fn( cost_fn )
+    , _in_queue( *this )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
@@ -130,7 +144,12 @@ public:
     static_assert( has_foreach_po_v<Ntk>, "Ntk does not implement the foreach_po method" );
     static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
 
-    add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    if ( _ps.incremental )
+    {
+      _fanout.build( static_cast<Ntk const&>( *this ) );
+    }
+
+    register_events();
   }
 
   /*! \brief Standard constructor.
@@ -143,6 +162,7 @@ public:
     , _levels( ntk )
     , _crit_path( ntk )
     , _cost_fn( cost_fn )
+    , _in_queue( ntk )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
     static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
@@ -155,7 +175,12 @@ public:
 
     update_levels();
 
-    add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    if ( _ps.incremental )
+    {
+      _fanout.build( static_cast<Ntk const&>( *this ) );
+    }
+
+    register_events();
   }
 
   /*! \brief Copy constructor. */
@@ -166,14 +191,19 @@ public:
     , _crit_path( other._crit_path )
     , _depth( other._depth )
     , _cost_fn( other._cost_fn )
+    , _crit_nodes( other._crit_nodes )
+    , _depth_dirty( other._depth_dirty )
+    , _levels_dirty( other._levels_dirty )
+    , _fanout( other._fanout )
+    , _in_queue( other._in_queue )
   {
-    add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    register_events();
   }
 
   depth_view<Ntk, NodeCostFn, false>& operator=( depth_view<Ntk, NodeCostFn, false> const& other )
   {
-    /* delete the event of this network */
-    Ntk::events().release_add_event( add_event );
+    /* delete the events of this network */
+    release_events();
 
     /* update the base class */
     this->_storage = other._storage;
@@ -185,20 +215,29 @@ public:
     _crit_path = other._crit_path;
     _depth = other._depth;
     _cost_fn = other._cost_fn;
+    _crit_nodes = other._crit_nodes;
+    _depth_dirty = other._depth_dirty;
+    _levels_dirty = other._levels_dirty;
+    _fanout = other._fanout;
+    _in_queue = other._in_queue;
 
-    /* register new event in the other network */
-    add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    /* register new events in the other network */
+    register_events();
 
     return *this;
   }
 
   ~depth_view()
   {
-    Ntk::events().release_add_event( add_event );
+    release_events();
   }
 
   uint32_t depth() const
   {
+    if ( _depth_dirty )
+    {
+      compute_depth();
+    }
     return _depth;
   }
 
@@ -209,26 +248,46 @@ public:
 
   bool is_on_critical_path( node const& n ) const
   {
+    if ( _depth_dirty )
+    {
+      compute_depth();
+    }
     return _crit_path[n];
   }
 
   void set_level( node const& n, uint32_t level )
   {
     _levels[n] = level;
+    if ( _ps.incremental )
+    {
+      _levels_dirty = true;
+      _depth_dirty = true;
+    }
   }
 
   void set_depth( uint32_t level )
   {
     _depth = level;
+    _depth_dirty = false;
   }
 
   void update_levels()
   {
+    if ( _ps.incremental && !_levels_dirty )
+    {
+      _depth_dirty = true;
+      return;
+    }
+
     _levels.reset( 0 );
     _crit_path.reset( false );
+    _crit_nodes.clear();
 
     this->incr_trav_id();
     compute_levels();
+
+    _depth_dirty = false;
+    _levels_dirty = false;
   }
 
   void resize_levels()
@@ -239,7 +298,21 @@ public:
   void create_po( signal const& f )
   {
     Ntk::create_po( f );
-    _depth = std::max( _depth, _levels[f] );
+    if ( _ps.incremental )
+    {
+      _depth_dirty = true;
+    }
+    else
+    {
+      _depth = std::max( _depth, _levels[f] );
+    }
+  }
+
+protected:
+  /*! \brief Fanouts of all nodes, which are only kept in incremental mode. */
+  detail::fanout_store const& incremental_fanouts() const
+  {
+    return _fanout;
   }
 
 private:
@@ -295,9 +368,41 @@ private:
     } );
   }
 
-  void set_critical_path( node const& n )
+  /* recomputes depth and critical paths from the levels */
+  void compute_depth() const
+  {
+    for ( auto const& n : _crit_nodes )
+    {
+      _crit_path[n] = false;
+    }
+    _crit_nodes.clear();
+    _crit_path.resize();
+
+    _depth = 0;
+    this->foreach_po( [&]( auto const& f ) {
+      auto clevel = _levels[f];
+      if ( _ps.count_complements && this->is_complemented( f ) )
+      {
+        clevel++;
+      }
+      _depth = std::max( _depth, clevel );
+    } );
+
+    this->foreach_po( [&]( auto const& f ) {
+      const auto n = this->get_node( f );
+      if ( _levels[n] == _depth && !_crit_path[n] )
+      {
+        set_critical_path( n );
+      }
+    } );
+
+    _depth_dirty = false;
+  }
+
+  void set_critical_path( node const& n ) const
   {
     _crit_path[n] = true;
+    _crit_nodes.push_back( n );
     if ( !this->is_constant( n ) && !( _ps.pi_cost && this->is_pi( n ) ) )
     {
       const auto lvl = _levels[n];
@@ -316,10 +421,9 @@ private:
     }
   }
 
-  void on_add( node const& n )
+  /* level of a gate from the current levels of its fanins */
+  uint32_t fanin_level( node const& n ) const
   {
-    _levels.resize();
-
     uint32_t level{0};
     this->foreach_fanin( n, [&]( auto const& f ) {
       auto clevel = _levels[f];
@@ -330,16 +434,132 @@ private:
       level = std::max( level, clevel );
     } );
 
-    _levels[n] = level + _cost_fn( *this, n );
+    return level + _cost_fn( *this, n );
+  }
+
+  void on_add( node const& n )
+  {
+    _levels.resize();
+    _levels[n] = fanin_level( n );
+
+    if ( _ps.incremental )
+    {
+      _crit_path.resize();
+      _fanout.resize( this->size() );
+      _fanout.add_parent( static_cast<Ntk const&>( *this ), n );
+    }
+  }
+
+  void on_modified( node const& n )
+  {
+    _fanout.remove_parent( this->node_to_index( n ) );
+    _fanout.add_parent( static_cast<Ntk const&>( *this ), n );
+    _depth_dirty = true;
+
+    propagate_levels( n );
+  }
+
+  void on_delete( node const& n )
+  {
+    _fanout.clear_fanouts( this->node_to_index( n ) );
+    _fanout.remove_parent( this->node_to_index( n ) );
+    _depth_dirty = true;
+  }
+
+  /* updates the levels of `n` and its transitive fanout, bucketed by their previous levels */
+  void propagate_levels( node const& n )
+  {
+    _in_queue.resize( 0 );
+
+    const auto first = _levels[n];
+    enqueue( n, first );
+    for ( auto l = first; l < _buckets.size(); ++l )
+    {
+      for ( auto i = 0u; i < _buckets[l].size(); ++i )
+      {
+        const auto p = _buckets[l][i];
+        _in_queue[p] = 0;
+
+        const auto level = fanin_level( p );
+        if ( level == _levels[p] )
+        {
+          continue;
+        }
+        _levels[p] = level;
+
+        const auto index = this->node_to_index( p );
+        std::for_each( _fanout.begin( index ), _fanout.end( index ), [&]( auto const& e ) {
+          const auto parent = this->index_to_node( e.parent );
+          enqueue( parent, std::max( l, _levels[parent] ) );
+        } );
+      }
+      _buckets[l].clear();
+    }
+  }
+
+  void enqueue( node const& n, uint32_t bucket )
+  {
+    if ( _in_queue[n] )
+    {
+      return;
+    }
+    _in_queue[n] = 1;
+
+    if ( bucket >= _buckets.size() )
+    {
+      _buckets.resize( bucket + 1u );
+    }
+    _buckets[bucket].push_back( n );
+  }
+
+  void register_events()
+  {
+    add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+
+    if ( _ps.incremental )
+    {
+      modified_event = Ntk::events().register_modified_event( [this]( auto const& n, auto const& previous ) {
+        (void)previous;
+        on_modified( n );
+      } );
+      delete_event = Ntk::events().register_delete_event( [this]( auto const& n ) { on_delete( n ); } );
+    }
+  }
+
+  void release_events()
+  {
+    Ntk::events().release_add_event( add_event );
+
+    if ( modified_event )
+    {
+      Ntk::events().release_modified_event( modified_event );
+    }
+
+    if ( delete_event )
+    {
+      Ntk::events().release_delete_event( delete_event );
+    }
   }
 
   depth_view_params _ps;
   node_map<uint32_t, Ntk> _levels;
-  node_map<uint32_t, Ntk> _crit_path;
-  uint32_t _depth{};
+  mutable node_map<uint32_t, Ntk> _crit_path;
+  mutable uint32_t _depth{};
   NodeCostFn _cost_fn;
 
+  /* nodes flagged as critical, to reset the flags */
+  mutable std::vector<node> _crit_nodes;
+  mutable bool _depth_dirty{false};
+  bool _levels_dirty{true};
+
+  /* fanouts and level update worklist in incremental mode */
+  detail::fanout_store _fanout;
+  node_map<uint8_t, Ntk> _in_queue;
+  std::vector<std::vector<node>> _buckets;
+
   std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> delete_event;
 };
 
 template<class T>
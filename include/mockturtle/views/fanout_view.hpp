@@ -36,10 +36,13 @@
 #include "../traits.hpp"
 #include "../networks/events.hpp"
 #include "../networks/detail/foreach.hpp"
+#include "../utils/fanout_store.hpp"
 #include "../utils/node_map.hpp"
 #include "immutable_view.hpp"
 
+#include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <stack>
 #include <vector>
 
@@ -60,6 +63,11 @@ struct fanout_view_params
  * fanout are computed at construction and can be recomputed by
  * calling the `update_fanout` method.
  *
+ * The fanouts of all nodes are kept in one pooled array, and updating the
+ * fanouts when a node is modified or deleted takes constant time per fanin
+ * of that node, independent of the number of fanouts of the fanins.  The
+ * order of fanouts is not preserved by updates.
+ *
  * **Required network functions:**
  * - `foreach_node`
  * - `foreach_fanin`
@@ -90,7 +98,6 @@ public:
 
   explicit fanout_view( fanout_view_params const& ps = {} )
     : Ntk()
-    , _fanout( *this )
     , _ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
@@ -104,7 +111,6 @@ public:
 
   explicit fanout_view( Ntk const& ntk, fanout_view_params const& ps = {} )
     : Ntk( ntk )
-    , _fanout( ntk )
     , _ps( ps )
   {
     static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
@@ -151,7 +157,9 @@ public:
   void foreach_fanout( node const& n, Fn&& fn ) const
   {
     assert( n < this->size() );
-    detail::foreach_element( _fanout[n].begin(), _fanout[n].end(), fn );
+    const auto index = this->node_to_index( n );
+    detail::foreach_element_transform<detail::fanout_store::entry const*, node>(
+        _fanout.begin( index ), _fanout.end( index ), [this]( auto const& e ) { return this->index_to_node( e.parent ); }, fn );
   }
 
   void update_fanout()
@@ -161,7 +169,15 @@ public:
 
   std::vector<node> fanout( node const& n ) const /* deprecated */
   {
-    return _fanout[n];
+    std::vector<node> fanouts;
+    foreach_fanout( n, [&]( auto const& p ) { fanouts.push_back( p ); } );
+    return fanouts;
+  }
+
+  /*! \brief Returns the number of bytes allocated for the fanouts. */
+  uint64_t fanout_memory_footprint() const
+  {
+    return _fanout.num_bytes();
   }
 
   void substitute_node( node const& old_node, signal const& new_signal )
@@ -174,7 +190,7 @@ public:
       const auto [_old, _new] = to_substitute.top();
       to_substitute.pop();
 
-      const auto parents = _fanout[_old];
+      const auto parents = fanout( _old );
       for ( auto n : parents )
       {
         if ( const auto repl = Ntk::replace_in_node( n, _old, _new ); repl )
@@ -197,33 +213,26 @@ private:
     if ( _ps.update_on_add )
     {
       add_event = Ntk::events().register_add_event( [this]( auto const& n ) {
-        _fanout.resize();
-        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
-        } );
+        _fanout.resize( this->size() );
+        add_parent( n );
       } );
     }
 
     if ( _ps.update_on_modified )
     {
       modified_event = Ntk::events().register_modified_event( [this]( auto const& n, auto const& previous ) {
+        /* the store remembers the previous fanins itself */
         (void)previous;
-        for ( auto const& f : previous ) {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
-        }
-        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].push_back( n );
-        } );
+        _fanout.remove_parent( this->node_to_index( n ) );
+        add_parent( n );
       } );
     }
 
     if ( _ps.update_on_delete )
     {
       delete_event = Ntk::events().register_delete_event( [this]( auto const& n ) {
-        _fanout[n].clear();
-        Ntk::foreach_fanin( n, [&, this]( auto const& f ) {
-          _fanout[f].erase( std::remove( _fanout[f].begin(), _fanout[f].end(), n ), _fanout[f].end() );
-        } );
+        _fanout.clear_fanouts( this->node_to_index( n ) );
+        _fanout.remove_parent( this->node_to_index( n ) );
       } );
     }
   }
@@ -246,22 +255,17 @@ private:
     }
   }
 
+  void add_parent( node const& n )
+  {
+    _fanout.add_parent( static_cast<Ntk const&>( *this ), n );
+  }
+
   void compute_fanout()
   {
-    _fanout.reset();
-
-    this->foreach_gate( [&]( auto const& n ){
-        this->foreach_fanin( n, [&]( auto const& c ){
-            auto& fanout = _fanout[c];
-            if ( std::find( fanout.begin(), fanout.end(), n ) == fanout.end() )
-            {
-              fanout.push_back( n );
-            }
-          });
-      });
+    _fanout.build( static_cast<Ntk const&>( *this ) );
   }
 
-  node_map<std::vector<node>, Ntk> _fanout;
+  detail::fanout_store _fanout;
   fanout_view_params _ps;
 
   std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
@@ -0,0 +1,310 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file frozen_view.hpp
+  \brief Read-only snapshot with fanins, fanouts, and levels in flat arrays
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "../networks/detail/foreach.hpp"
+#include "../traits.hpp"
+#include "immutable_view.hpp"
+
+namespace mockturtle
+{
+
+/*! \brief Read-only snapshot of a network for analysis passes.
+ *
+ * This view computes *on construction* a topological order of all nodes,
+ * the fanins and fanouts of all nodes, and the level of all nodes, and
+ * stores them in flat arrays.  Fanins and fanouts are kept in
+ * compressed-sparse-row form: one array with the fanins (fanouts) of all
+ * nodes, and one array of offsets into it.  All arrays are ordered by the
+ * position of a node in the topological order, which is looked up once
+ * per node from its index, such that a pass over the nodes in topological
+ * order reads them sequentially.  It
+ * implements the network interface methods `foreach_node`, `foreach_gate`,
+ * `foreach_fanin`, `fanin_size`, `foreach_fanout`, `level`, and `depth`, and
+ * therefore replaces a combination of `topo_view`, `fanout_view`, and
+ * `depth_view` for passes that do not modify the network.
+ *
+ * Constant nodes and CIs are visited first, followed by all gates (also
+ * dangling ones) in topological order.  Fanouts do not include COs, and
+ * levels are computed with unit cost and without counting complemented
+ * edges.  Since all data is computed only once, this view disables changes
+ * to the network interface, and the network must not be changed through
+ * other references while the view is in use.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `get_constant`
+ * - `node_to_index`
+ * - `foreach_ci`
+ * - `foreach_co`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `incr_trav_id`
+ * - `set_visited`
+ * - `trav_id`
+ * - `visited`
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      aig_network aig = ...;
+
+      frozen_view frozen{aig};
+      std::cout << "Depth: " << frozen.depth() << "\n";
+      auto const tts = simulate<kitty::static_truth_table<8>>( frozen );
+   \endverbatim
+ */
+template<class Ntk>
+class frozen_view : public immutable_view<Ntk>
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  static constexpr bool is_topologically_sorted = true;
+
+  explicit frozen_view( Ntk const& ntk ) : immutable_view<Ntk>( ntk )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_size_v<Ntk>, "Ntk does not implement the size method" );
+    static_assert( has_get_node_v<Ntk>, "Ntk does not implement the get_node method" );
+    static_assert( has_get_constant_v<Ntk>, "Ntk does not implement the get_constant method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_foreach_ci_v<Ntk>, "Ntk does not implement the foreach_ci method" );
+    static_assert( has_foreach_co_v<Ntk>, "Ntk does not implement the foreach_co method" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_incr_trav_id_v<Ntk>, "Ntk does not implement the incr_trav_id method" );
+    static_assert( has_set_visited_v<Ntk>, "Ntk does not implement the set_visited method" );
+    static_assert( has_trav_id_v<Ntk>, "Ntk does not implement the trav_id method" );
+    static_assert( has_visited_v<Ntk>, "Ntk does not implement the visited method" );
+
+    compute_topo_order();
+    compute_fanins();
+    compute_fanouts();
+    compute_levels();
+  }
+
+  /*! \brief Reimplementation of `foreach_node`. */
+  template<typename Fn>
+  void foreach_node( Fn&& fn ) const
+  {
+    detail::foreach_element( _topo_order.begin(), _topo_order.end(), fn );
+  }
+
+  /*! \brief Reimplementation of `foreach_gate`. */
+  template<typename Fn>
+  void foreach_gate( Fn&& fn ) const
+  {
+    detail::foreach_element( _topo_order.begin() + _num_leaves, _topo_order.end(), fn );
+  }
+
+  /*! \brief Reimplementation of `foreach_fanin`. */
+  template<typename Fn>
+  void foreach_fanin( node const& n, Fn&& fn ) const
+  {
+    const auto pos = position( n );
+    detail::foreach_element( _fanins.begin() + _fanin_offsets[pos], _fanins.begin() + _fanin_offsets[pos + 1u], fn );
+  }
+
+  /*! \brief Reimplementation of `fanin_size`. */
+  uint32_t fanin_size( node const& n ) const
+  {
+    const auto pos = position( n );
+    return _fanin_offsets[pos + 1u] - _fanin_offsets[pos];
+  }
+
+  /*! \brief Iterates over the gates that have `n` as a fanin. */
+  template<typename Fn>
+  void foreach_fanout( node const& n, Fn&& fn ) const
+  {
+    const auto pos = position( n );
+    detail::foreach_element( _fanouts.begin() + _fanout_offsets[pos], _fanouts.begin() + _fanout_offsets[pos + 1u], fn );
+  }
+
+  /*! \brief Returns the level of a node (CIs and constants have level 0). */
+  uint32_t level( node const& n ) const
+  {
+    return _levels[position( n )];
+  }
+
+  /*! \brief Returns the largest level of any CO. */
+  uint32_t depth() const
+  {
+    return _depth;
+  }
+
+private:
+  uint32_t position( node const& n ) const
+  {
+    return _positions[this->node_to_index( n )];
+  }
+
+  void compute_topo_order()
+  {
+    _topo_order.reserve( this->size() );
+    this->incr_trav_id();
+    const auto mark = [&]( node const& n ) {
+      if ( this->visited( n ) != this->trav_id() )
+      {
+        this->set_visited( n, this->trav_id() );
+        _topo_order.push_back( n );
+      }
+    };
+
+    mark( this->get_node( this->get_constant( false ) ) );
+    mark( this->get_node( this->get_constant( true ) ) );
+    Ntk::foreach_ci( mark );
+    _num_leaves = static_cast<uint32_t>( _topo_order.size() );
+
+    /* depth-first search without recursion; the flag tells whether the
+     * fanins of a node have already been put on the stack */
+    std::vector<std::pair<node, bool>> stack;
+    Ntk::foreach_gate( [&]( auto const& g ) {
+      stack.emplace_back( g, false );
+      while ( !stack.empty() )
+      {
+        auto const [n, expanded] = stack.back();
+        if ( this->visited( n ) == this->trav_id() )
+        {
+          stack.pop_back();
+        }
+        else if ( expanded )
+        {
+          stack.pop_back();
+          mark( n );
+        }
+        else
+        {
+          stack.back().second = true;
+          Ntk::foreach_fanin( n, [&]( auto const& f ) {
+            if ( this->visited( this->get_node( f ) ) != this->trav_id() )
+            {
+              stack.emplace_back( this->get_node( f ), false );
+            }
+          } );
+        }
+      }
+    } );
+
+    /* nodes that are not visited (e.g., dead nodes) are placed after all
+     * others and have neither fanins nor fanouts */
+    const auto num_visited = static_cast<uint32_t>( _topo_order.size() );
+    _positions.assign( this->size(), num_visited );
+    for ( auto i = 0u; i < num_visited; ++i )
+    {
+      _positions[this->node_to_index( _topo_order[i] )] = i;
+    }
+  }
+
+  void compute_fanins()
+  {
+    /* positions of the leaves have no fanins, and the gates follow in
+     * topological order, so the arrays are filled in one pass */
+    _fanin_offsets.assign( _num_leaves + 1u, 0u );
+    _fanin_offsets.reserve( _topo_order.size() + 2u );
+    for ( auto i = _num_leaves; i < _topo_order.size(); ++i )
+    {
+      Ntk::foreach_fanin( _topo_order[i], [&]( auto const& f ) {
+        _fanins.push_back( f );
+      } );
+      _fanin_offsets.push_back( static_cast<uint32_t>( _fanins.size() ) );
+    }
+    _fanin_offsets.push_back( static_cast<uint32_t>( _fanins.size() ) );
+  }
+
+  void compute_fanouts()
+  {
+    _fanout_offsets.assign( _topo_order.size() + 2u, 0u );
+    for ( auto const& f : _fanins )
+    {
+      ++_fanout_offsets[position( this->get_node( f ) ) + 1u];
+    }
+    std::partial_sum( _fanout_offsets.begin(), _fanout_offsets.end(), _fanout_offsets.begin() );
+
+    /* fanouts of every node appear in topological order */
+    _fanouts.resize( _fanout_offsets.back() );
+    std::vector<uint32_t> pos( _fanout_offsets.begin(), _fanout_offsets.end() - 1 );
+    foreach_gate( [&]( auto const& n ) {
+      foreach_fanin( n, [&]( auto const& f ) {
+        _fanouts[pos[position( this->get_node( f ) )]++] = n;
+      } );
+    } );
+  }
+
+  void compute_levels()
+  {
+    _levels.assign( _topo_order.size() + 1u, 0u );
+    for ( auto i = _num_leaves; i < _topo_order.size(); ++i )
+    {
+      uint32_t level{0};
+      foreach_fanin( _topo_order[i], [&]( auto const& f ) {
+        level = std::max( level, _levels[position( this->get_node( f ) )] );
+      } );
+      _levels[i] = level + 1u;
+    }
+
+    _depth = 0u;
+    Ntk::foreach_co( [&]( auto const& f ) {
+      _depth = std::max( _depth, _levels[position( this->get_node( f ) )] );
+    } );
+  }
+
+private:
+  std::vector<node> _topo_order;
+  uint32_t _num_leaves{0};
+  std::vector<uint32_t> _positions;
+
+  std::vector<uint32_t> _fanin_offsets;
+  std::vector<signal> _fanins;
+  std::vector<uint32_t> _fanout_offsets;
+  std::vector<node> _fanouts;
+
+  std::vector<uint32_t> _levels;
+  uint32_t _depth{0};
+};
+
+template<class T>
+frozen_view( T const& ) -> frozen_view<T>;
+
+} // namespace mockturtle
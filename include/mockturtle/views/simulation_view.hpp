@@ -0,0 +1,284 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file simulation_view.hpp
+  \brief Caches partial simulation values under network edits
+*/
+
+#pragma once
+
+#include "../algorithms/simulation.hpp"
+#include "../traits.hpp"
+#include "../utils/fanout_tracker.hpp"
+#include "../utils/node_map.hpp"
+
+#include <kitty/partial_truth_table.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Keeps partial simulation values of all nodes up-to-date.
+ *
+ * This view stores for each node its simulation value under the patterns
+ * of a `partial_simulator` (or `bit_packed_simulator`), which is passed by
+ * reference and may grow while the view exists.  The values are computed
+ * when they are queried with `simulation_value`, in topological order and
+ * only for the nodes in the transitive fanin that are out of date.
+ *
+ * Created nodes and nodes whose fanins change, together with their
+ * transitive fanout, are simulated again when they are queried.  When
+ * patterns have been appended to the simulator, only the new words of AND,
+ * XOR, MAJ, and XOR3 gates are computed; the values of other gates are
+ * recomputed as a whole.  If the simulator changes existing patterns
+ * (e.g., `bit_packed_simulator::pack_bits`), `invalidate_values` must be
+ * called.
+ *
+ * The view simulates combinational networks.  Querying a node that
+ * depends on a register output throws `std::invalid_argument`.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `node_to_index`
+ * - `index_to_node`
+ * - `foreach_gate`
+ * - `foreach_fanin`
+ * - `foreach_pi`
+ * - `compute<kitty::partial_truth_table>`
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      partial_simulator sim( aig.num_pis(), 1024 );
+      simulation_view saig{aig, sim};
+
+      auto const& tt = saig.simulation_value( n );
+      saig.substitute_node( m, f );   // marks the fanout of m as out of date
+      sim.add_pattern( cex );         // only the new words are simulated
+      auto const& tt2 = saig.simulation_value( n );
+   \endverbatim
+ */
+template<class Ntk, class Simulator = partial_simulator>
+class simulation_view : public Ntk
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  explicit simulation_view( Ntk const& ntk, Simulator const& sim )
+      : Ntk( ntk ),
+        _sim( &sim ),
+        _values( ntk ),
+        _dirty( ntk, 1u )
+  {
+    static_assert( is_network_type_v<Ntk>, "Ntk is not a network type" );
+    static_assert( has_foreach_gate_v<Ntk>, "Ntk does not implement the foreach_gate method" );
+    static_assert( has_foreach_fanin_v<Ntk>, "Ntk does not implement the foreach_fanin method" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+    static_assert( has_compute_v<Ntk, kitty::partial_truth_table>, "Ntk does not implement the compute method for kitty::partial_truth_table" );
+
+    _tracker.build( *this );
+    track_events();
+  }
+
+  /*! \brief Copy constructor. */
+  simulation_view( simulation_view<Ntk, Simulator> const& other )
+      : Ntk( other ),
+        _sim( other._sim ),
+        _values( other._values ),
+        _dirty( other._dirty ),
+        _tracker( other._tracker )
+  {
+    track_events();
+  }
+
+  simulation_view<Ntk, Simulator>& operator=( simulation_view<Ntk, Simulator> const& other )
+  {
+    _tracker.release();
+
+    /* update the base class */
+    this->_storage = other._storage;
+    this->_events = other._events;
+
+    /* copy */
+    _sim = other._sim;
+    _values = other._values;
+    _dirty = other._dirty;
+    _tracker = other._tracker;
+
+    track_events();
+
+    return *this;
+  }
+
+  /*! \brief Returns the simulation value of `n` under all current patterns. */
+  kitty::partial_truth_table const& simulation_value( node const& n ) const
+  {
+    if ( !is_up_to_date( n ) )
+    {
+      update( n );
+    }
+    return _values[n];
+  }
+
+  /*! \brief Returns whether the value of `n` can be returned without simulation. */
+  bool is_up_to_date( node const& n ) const
+  {
+    return !_dirty[n] && _values[n].num_bits() == _sim->num_bits();
+  }
+
+  /*! \brief Marks all values as out of date. */
+  void invalidate_values()
+  {
+    _dirty.reset( 1u );
+  }
+
+private:
+  /* simulates the out-of-date nodes in the transitive fanin of `n` in topological order */
+  void update( node const& n ) const
+  {
+    _stack.push_back( n );
+    while ( !_stack.empty() )
+    {
+      const auto m = _stack.back();
+      if ( is_up_to_date( m ) )
+      {
+        _stack.pop_back();
+        continue;
+      }
+
+      bool ready = true;
+      if ( !this->is_ci( m ) && !this->is_constant( m ) )
+      {
+        this->foreach_fanin( m, [&]( auto const& f ) {
+          if ( const auto c = this->get_node( f ); !is_up_to_date( c ) )
+          {
+            ready = false;
+            _stack.push_back( c );
+          }
+        } );
+      }
+
+      if ( ready )
+      {
+        _stack.pop_back();
+        compute_value( m );
+      }
+    }
+  }
+
+  void compute_value( node const& n ) const
+  {
+    auto& value = _values[n];
+
+    if ( this->is_constant( n ) )
+    {
+      value = _sim->compute_constant( this->constant_value( n ) );
+    }
+    else if ( this->is_ci( n ) )
+    {
+      /* copying the patterns of all PIs at once does not require `pi_index` */
+      this->foreach_pi( [&]( auto const& pi, auto i ) {
+        if ( !is_up_to_date( pi ) )
+        {
+          _values[pi] = _sim->compute_pi( i );
+          _dirty[pi] = 0u;
+        }
+      } );
+
+      /* the simulator has no patterns for register outputs */
+      if ( !is_up_to_date( n ) )
+      {
+        throw std::invalid_argument( "simulation_view does not support register outputs" );
+      }
+    }
+    else if ( !_dirty[n] && value.num_bits() > 0u && value.num_bits() < _sim->num_bits() && detail::is_kernel_gate( *this, n ) )
+    {
+      /* patterns have been appended: recompute from the last (partial) word on */
+      const auto first = value.num_blocks() - 1u;
+      value.resize( _sim->num_bits() );
+      detail::compute_gate_words( *this, n, _values, first, value.num_blocks() - first );
+      value.mask_bits();
+    }
+    else if ( !detail::compute_gate_inplace( *this, n, _values ) )
+    {
+      _fanin_values.resize( this->fanin_size( n ) );
+      this->foreach_fanin( n, [&]( auto const& f, auto i ) {
+        _fanin_values[i] = _values[this->get_node( f )];
+      } );
+      value = Ntk::compute( n, _fanin_values.begin(), _fanin_values.end() );
+    }
+
+    _dirty[n] = 0u;
+  }
+
+  void track_events()
+  {
+    _tracker.track(
+        *this,
+        [this]( auto const& n ) {
+          (void)n;
+          _values.resize();
+          _dirty.resize( 1u );
+        },
+        [this]( auto const& n ) {
+          _dirty[n] = 0u; /* such that the fanout is visited */
+          _tracker.mark_tfo( n, [this]( auto const& m ) {
+            if ( _dirty[m] )
+            {
+              return false;
+            }
+            _dirty[m] = 1u;
+            return true;
+          } );
+        },
+        [this]( auto const& n ) {
+          _values[n] = kitty::partial_truth_table();
+        } );
+  }
+
+  Simulator const* _sim;
+  mutable node_map<kitty::partial_truth_table, Ntk> _values;
+  mutable node_map<uint8_t, Ntk> _dirty;
+  detail::fanout_tracker<Ntk> _tracker;
+  mutable std::vector<node> _stack;
+  mutable std::vector<kitty::partial_truth_table> _fanin_values;
+};
+
+template<class T, class Simulator>
+simulation_view( T const&, Simulator const& ) -> simulation_view<T, Simulator>;
+
+} // namespace mockturtle
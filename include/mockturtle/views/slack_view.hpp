@@ -0,0 +1,424 @@
+/* mockturtle: C++ logic network library
+ * Copyright (C) 2018-2021  EPFL
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without
+ * restriction, including without limitation the rights to use,
+ * copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following
+ * conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ * NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/*!
+  \file slack_view.hpp
+  \brief Implements arrival times, required times, and slack for a network
+*/
+
+#pragma once
+
+#include "../traits.hpp"
+#include "../utils/cost_functions.hpp"
+#include "../utils/node_map.hpp"
+#include "../networks/events.hpp"
+#include "depth_view.hpp"
+#include "fanout_view.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace mockturtle
+{
+
+/*! \brief Implements `arrival`, `required`, and `slack` methods for networks.
+ *
+ * This view extends an incremental `depth_view`, whose levels are the
+ * arrival times of the nodes.  For each node, it additionally keeps the
+ * largest delay from the node to any PO, such that the required time of a
+ * node is the required time of the network minus this delay.  The required
+ * time of the network is the depth, unless it is set with
+ * `set_required_time`.
+ *
+ * Arrival times are updated when nodes are created, modified, or deleted
+ * (see `depth_view_params::incremental`).  The delays to the POs are
+ * updated backwards from the fanins of the changed nodes, in the reverse
+ * order of their levels, and the update stops at nodes whose delay does
+ * not change.  The backward update is deferred until the next query.
+ * POs are rescanned only if the driver of some PO has been deleted.  The
+ * fanouts of the nodes are shared with the incremental `depth_view`.
+ *
+ * The network must not already provide the depth interface.
+ *
+ * **Required network functions:**
+ * - `size`
+ * - `get_node`
+ * - `node_to_index`
+ * - `index_to_node`
+ * - `foreach_fanin`
+ * - `foreach_po`
+ *
+ * Example
+ *
+   \verbatim embed:rst
+
+   .. code-block:: c++
+
+      // create network somehow
+      aig_network aig = ...;
+
+      // create a slack view on the network
+      slack_view aig_slack{aig};
+
+      // replace a node only if the replacement does not increase the depth
+      if ( aig_slack.is_timing_legal( n, candidate ) )
+      {
+        aig_slack.substitute_node( n, candidate );
+      }
+   \endverbatim
+ */
+template<class Ntk, class NodeCostFn = unit_cost<Ntk>>
+class slack_view : public depth_view<Ntk, NodeCostFn>
+{
+public:
+  using storage = typename Ntk::storage;
+  using node = typename Ntk::node;
+  using signal = typename Ntk::signal;
+
+  /*! \brief Standard constructor.
+   *
+   * \param ntk Base network
+   */
+  explicit slack_view( Ntk const& ntk, NodeCostFn const& cost_fn = {}, depth_view_params const& ps = {} )
+      : depth_view<Ntk, NodeCostFn>( ntk, cost_fn, incremental_params( ps ) ),
+        _ps( ps ),
+        _cost_fn( cost_fn ),
+        _delay( *this ),
+        _po_delay( *this ),
+        _in_queue( *this )
+  {
+    static_assert( !has_depth_v<Ntk>, "Ntk already implements the depth interface" );
+    static_assert( has_node_to_index_v<Ntk>, "Ntk does not implement the node_to_index method" );
+    static_assert( has_index_to_node_v<Ntk>, "Ntk does not implement the index_to_node method" );
+
+    _po_delay.reset( no_output );
+    _in_queue.reset( 0 );
+    update_outputs();
+    this->foreach_node( [&]( auto const& n ) {
+      enqueue( n );
+    } );
+
+    register_events();
+  }
+
+  /*! \brief Copy constructor. */
+  slack_view( slack_view<Ntk, NodeCostFn> const& other )
+      : depth_view<Ntk, NodeCostFn>( other ),
+        _ps( other._ps ),
+        _cost_fn( other._cost_fn ),
+        _required_time( other._required_time ),
+        _delay( other._delay ),
+        _po_delay( other._po_delay ),
+        _po_drivers( other._po_drivers ),
+        _outputs_dirty( other._outputs_dirty ),
+        _in_queue( other._in_queue ),
+        _buckets( other._buckets )
+  {
+    register_events();
+  }
+
+  slack_view<Ntk, NodeCostFn>& operator=( slack_view<Ntk, NodeCostFn> const& other )
+  {
+    release_events();
+
+    depth_view<Ntk, NodeCostFn>::operator=( other );
+
+    _ps = other._ps;
+    _cost_fn = other._cost_fn;
+    _required_time = other._required_time;
+    _delay = other._delay;
+    _po_delay = other._po_delay;
+    _po_drivers = other._po_drivers;
+    _outputs_dirty = other._outputs_dirty;
+    _in_queue = other._in_queue;
+    _buckets = other._buckets;
+
+    register_events();
+
+    return *this;
+  }
+
+  ~slack_view()
+  {
+    release_events();
+  }
+
+  /*! \brief Returns the arrival time (level) of a node. */
+  uint32_t arrival( node const& n ) const
+  {
+    return this->level( n );
+  }
+
+  /*! \brief Returns the required time of a node. */
+  int32_t required( node const& n ) const
+  {
+    update_delays();
+    return static_cast<int32_t>( required_time() ) - static_cast<int32_t>( _delay[n] );
+  }
+
+  /*! \brief Returns the slack of a node, which is negative for nodes that
+   *         violate the required time. */
+  int32_t slack( node const& n ) const
+  {
+    return required( n ) - static_cast<int32_t>( arrival( n ) );
+  }
+
+  /*! \brief Checks whether replacing `n` with `f` keeps the required time.
+   *
+   * The replacement is legal if the arrival time of `f` does not exceed the
+   * required time of `n`.  Complemented edges are not taken into account.
+   */
+  bool is_timing_legal( node const& n, signal const& f ) const
+  {
+    return static_cast<int32_t>( arrival( this->get_node( f ) ) ) <= required( n );
+  }
+
+  /*! \brief Returns the required time of the network. */
+  uint32_t required_time() const
+  {
+    return _required_time == 0u ? this->depth() : _required_time;
+  }
+
+  /*! \brief Sets the required time of the network (0 for the depth). */
+  void set_required_time( uint32_t required_time )
+  {
+    _required_time = required_time;
+  }
+
+  void create_po( signal const& f )
+  {
+    depth_view<Ntk, NodeCostFn>::create_po( f );
+
+    const auto n = this->get_node( f );
+    const auto delay = edge_delay( f );
+    if ( _po_delay[n] == no_output )
+    {
+      _po_delay[n] = delay;
+      _po_drivers.push_back( n );
+    }
+    else
+    {
+      _po_delay[n] = std::max( _po_delay[n], delay );
+    }
+    enqueue( n );
+  }
+
+private:
+  static constexpr uint32_t no_output = std::numeric_limits<uint32_t>::max();
+
+  static depth_view_params incremental_params( depth_view_params ps )
+  {
+    ps.incremental = true;
+    return ps;
+  }
+
+  uint32_t edge_delay( signal const& f ) const
+  {
+    return ( _ps.count_complements && this->is_complemented( f ) ) ? 1u : 0u;
+  }
+
+  /* largest delay from `n` to a PO through its current fanouts */
+  uint32_t compute_delay( node const& n ) const
+  {
+    uint32_t delay = _po_delay[n] == no_output ? 0u : _po_delay[n];
+
+    auto const& fanout = this->incremental_fanouts();
+    const auto index = this->node_to_index( n );
+    std::for_each( fanout.begin( index ), fanout.end( index ), [&]( auto const& e ) {
+      const auto p = this->index_to_node( e.parent );
+      uint32_t offset{0};
+      if ( _ps.count_complements )
+      {
+        this->foreach_fanin( p, [&]( auto const& f ) {
+          if ( this->get_node( f ) == n )
+          {
+            offset = std::max( offset, edge_delay( f ) );
+          }
+        } );
+      }
+      delay = std::max( delay, _delay[p] + _cost_fn( *this, p ) + offset );
+    } );
+
+    return delay;
+  }
+
+  /* recomputes the PO delays of all drivers */
+  void update_outputs() const
+  {
+    for ( auto const& n : _po_drivers )
+    {
+      _po_delay[n] = no_output;
+      enqueue( n );
+    }
+    _po_drivers.clear();
+
+    this->foreach_po( [&]( auto const& f ) {
+      const auto n = this->get_node( f );
+      if ( _po_delay[n] == no_output )
+      {
+        _po_delay[n] = edge_delay( f );
+        _po_drivers.push_back( n );
+        enqueue( n );
+      }
+      else
+      {
+        _po_delay[n] = std::max( _po_delay[n], edge_delay( f ) );
+      }
+    } );
+
+    _outputs_dirty = false;
+  }
+
+  /* processes the pending nodes from the highest to the lowest level */
+  void update_delays() const
+  {
+    if ( _outputs_dirty )
+    {
+      update_outputs();
+    }
+
+    for ( auto l = static_cast<uint32_t>( _buckets.size() ); l-- > 0u; )
+    {
+      for ( auto i = 0u; i < _buckets[l].size(); ++i )
+      {
+        const auto n = _buckets[l][i];
+        _in_queue[n] = 0;
+
+        if constexpr ( has_is_dead_v<Ntk> )
+        {
+          if ( this->is_dead( n ) )
+          {
+            continue;
+          }
+        }
+
+        const auto delay = compute_delay( n );
+        if ( delay == _delay[n] )
+        {
+          continue;
+        }
+        _delay[n] = delay;
+
+        this->foreach_fanin( n, [&]( auto const& f ) {
+          enqueue( this->get_node( f ), l );
+        } );
+      }
+      _buckets[l].clear();
+    }
+  }
+
+  void enqueue( node const& n, uint32_t max_bucket = std::numeric_limits<uint32_t>::max() ) const
+  {
+    if ( _in_queue[n] )
+    {
+      return;
+    }
+    _in_queue[n] = 1;
+
+    const auto bucket = std::min( this->level( n ), max_bucket );
+    if ( bucket >= _buckets.size() )
+    {
+      _buckets.resize( bucket + 1u );
+    }
+    _buckets[bucket].push_back( n );
+  }
+
+  void enqueue_fanins( node const& n ) const
+  {
+    this->foreach_fanin( n, [&]( auto const& f ) {
+      enqueue( this->get_node( f ) );
+    } );
+  }
+
+  void on_add( node const& n )
+  {
+    _delay.resize( 0 );
+    _po_delay.resize( no_output );
+    _in_queue.resize( 0 );
+    enqueue_fanins( n );
+  }
+
+  template<typename Previous>
+  void on_modified( node const& n, Previous const& previous )
+  {
+    for ( auto const& f : previous )
+    {
+      enqueue( this->get_node( f ) );
+    }
+    enqueue_fanins( n );
+  }
+
+  void on_delete( node const& n )
+  {
+    enqueue_fanins( n );
+
+    if ( _po_delay[n] != no_output )
+    {
+      _outputs_dirty = true;
+    }
+  }
+
+  void register_events()
+  {
+    add_event = Ntk::events().register_add_event( [this]( auto const& n ) { on_add( n ); } );
+    modified_event = Ntk::events().register_modified_event( [this]( auto const& n, auto const& previous ) { on_modified( n, previous ); } );
+    delete_event = Ntk::events().register_delete_event( [this]( auto const& n ) { on_delete( n ); } );
+  }
+
+  void release_events()
+  {
+    Ntk::events().release_add_event( add_event );
+    Ntk::events().release_modified_event( modified_event );
+    Ntk::events().release_delete_event( delete_event );
+  }
+
+  depth_view_params _ps;
+  NodeCostFn _cost_fn;
+  uint32_t _required_time{0};
+
+  /* largest delay to a PO, and delay of the POs driven by a node */
+  mutable node_map<uint32_t, Ntk> _delay;
+  mutable node_map<uint32_t, Ntk> _po_delay;
+  mutable std::vector<node> _po_drivers;
+  mutable bool _outputs_dirty{false};
+
+  /* backward update worklist; the fanouts are kept by the incremental depth_view */
+  mutable node_map<uint8_t, Ntk> _in_queue;
+  mutable std::vector<std::vector<node>> _buckets;
+
+  std::shared_ptr<typename network_events<Ntk>::add_event_type> add_event;
+  std::shared_ptr<typename network_events<Ntk>::modified_event_type> modified_event;
+  std::shared_ptr<typename network_events<Ntk>::delete_event_type> delete_event;
+};
+
+template<class T>
+slack_view( T const& )->slack_view<T>;
+
+template<class T, class NodeCostFn = unit_cost<T>>
+slack_view( T const&, NodeCostFn const&, depth_view_params const& )->slack_view<T, NodeCostFn>;
+
+} // namespace mockturtle
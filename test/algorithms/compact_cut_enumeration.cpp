@@ -0,0 +1,107 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/compact_cut_enumeration.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/cut_enumeration/mf_cut.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+
+#include <vector>
+
+#include "../test_networks.hpp"
+
+using namespace mockturtle;
+
+template<class Ntk>
+void check_compact_cut_enumeration()
+{
+  const auto ntk = multiplier_network<Ntk>( 6u );
+
+  compact_cut_enumeration_params ps;
+  ps.cut_size = 5u;
+  ps.cut_limit = 10u;
+
+  const auto cuts = cut_enumeration<Ntk, true>( ntk, ps );
+  const auto compact = compact_cut_enumeration<Ntk, true>( ntk, ps );
+  CHECK( compact.nodes_size() == cuts.nodes_size() );
+  CHECK( compact.total_cuts() == cuts.total_cuts() );
+  CHECK( compact.total_tuples() == cuts.total_tuples() );
+
+  ntk.foreach_node( [&]( auto const& n ) {
+    const auto index = ntk.node_to_index( n );
+    CHECK( compact.num_cuts( index ) == cuts.cuts( index ).size() );
+    check_same_cut_set( cuts, cuts.cuts( index ), compact, compact.cuts( index ) );
+  } );
+
+  CHECK( compact.num_bytes() < ntk.size() * sizeof( typename network_cuts<Ntk, true, empty_cut_data>::cut_set_t ) );
+}
+
+TEST_CASE( "compact cut enumeration computes the same cuts as cut enumeration", "[compact_cut_enumeration]" )
+{
+  check_compact_cut_enumeration<aig_network>();
+  check_compact_cut_enumeration<mig_network>();
+  check_compact_cut_enumeration<klut_network>();
+}
+
+TEST_CASE( "compact cut enumeration with cut data", "[compact_cut_enumeration]" )
+{
+  const auto aig = multiplier_network<aig_network>( 5u );
+
+  compact_cut_enumeration_params ps;
+  ps.cut_size = 4u;
+  ps.cut_limit = 8u;
+
+  const auto cuts = cut_enumeration<aig_network, false, cut_enumeration_mf_cut>( aig, ps );
+  const auto compact = compact_cut_enumeration<aig_network, false, cut_enumeration_mf_cut>( aig, ps );
+
+  aig.foreach_node( [&]( auto const& n ) {
+    const auto index = aig.node_to_index( n );
+    auto const& set1 = cuts.cuts( index );
+    auto const& set2 = compact.cuts( index );
+    REQUIRE( set1.size() == set2.size() );
+    for ( auto j = 0u; j < set1.size(); ++j )
+    {
+      CHECK( std::vector<uint32_t>( set1[j].begin(), set1[j].end() ) == std::vector<uint32_t>( set2[j].begin(), set2[j].end() ) );
+
+      /* the data of unit cuts is not updated */
+      if ( set1[j].size() == 1u && *set1[j].begin() == index )
+      {
+        continue;
+      }
+      CHECK( set1[j]->data.delay == set2[j]->data.delay );
+      CHECK( set1[j]->data.flow == set2[j]->data.flow );
+    }
+  } );
+}
+
+TEST_CASE( "streaming compact cut enumeration", "[compact_cut_enumeration]" )
+{
+  const auto aig = multiplier_network<aig_network>( 8u );
+
+  compact_cut_enumeration_params ps;
+  ps.cut_size = 5u;
+  ps.cut_limit = 10u;
+
+  const auto cuts = cut_enumeration<aig_network, true>( aig, ps );
+  const auto all = compact_cut_enumeration<aig_network, true>( aig, ps );
+
+  /* the callback sees every cut set once, in topological order */
+  ps.streaming = true;
+  uint32_t num_calls{0u};
+  std::vector<bool> seen( aig.size(), false );
+  const auto frontier = compact_cut_enumeration<aig_network, true>( aig, ps, nullptr, [&]( auto const& n, auto const& set ) {
+    const auto index = aig.node_to_index( n );
+    CHECK( !seen[index] );
+    seen[index] = true;
+    ++num_calls;
+    check_same_cut_set( cuts, cuts.cuts( index ), all, set );
+  } );
+  CHECK( num_calls == aig.size() );
+
+  /* no cut set is kept after the last node */
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( !frontier.has_cuts( aig.node_to_index( n ) ) );
+  } );
+  CHECK( frontier.peak_num_bytes() < all.peak_num_bytes() );
+}
@@ -8,6 +8,8 @@
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/klut.hpp>
 
+#include "../test_networks.hpp"
+
 using namespace mockturtle;
 
 TEST_CASE( "enumerate cuts for an AIG", "[cut_enumeration]" )
@@ -176,6 +178,48 @@ TEST_CASE( "compute XOR network cuts in 2-LUT network", "[cut_enumeration]" )
   }
 }
 
+template<class Cuts1, class Cuts2>
+void check_same_cuts( Cuts1 const& cuts1, Cuts2 const& cuts2 )
+{
+  CHECK( cuts1.total_tuples() == cuts2.total_tuples() );
+  CHECK( cuts1.total_cuts() == cuts2.total_cuts() );
+  REQUIRE( cuts1.nodes_size() == cuts2.nodes_size() );
+  for ( auto i = 0u; i < cuts1.nodes_size(); ++i )
+  {
+    REQUIRE( cuts1.cuts( i ).size() == cuts2.cuts( i ).size() );
+    for ( auto j = 0u; j < cuts1.cuts( i ).size(); ++j )
+    {
+      auto const& c1 = cuts1.cuts( i )[j];
+      auto const& c2 = cuts2.cuts( i )[j];
+      CHECK( std::vector<uint32_t>( c1.begin(), c1.end() ) == std::vector<uint32_t>( c2.begin(), c2.end() ) );
+      CHECK( c1->func_id == c2->func_id );
+    }
+  }
+}
+
+TEST_CASE( "enumerate cuts with several threads", "[cut_enumeration]" )
+{
+  const auto aig = multiplier_network<aig_network>( 6u );
+  const auto klut = multiplier_network<klut_network>( 5u );
+
+  cut_enumeration_params ps;
+  ps.cut_size = 6u;
+  ps.cut_limit = 12u;
+
+  cut_enumeration_params ps_mt = ps;
+  ps_mt.num_threads = 4u;
+
+  check_same_cuts( cut_enumeration<aig_network, true>( aig, ps ), cut_enumeration<aig_network, true>( aig, ps_mt ) );
+  check_same_cuts( cut_enumeration<klut_network, true>( klut, ps ), cut_enumeration<klut_network, true>( klut, ps_mt ) );
+  check_same_cuts( fast_cut_enumeration<aig_network, 6u, true>( aig, ps ), fast_cut_enumeration<aig_network, 6u, true>( aig, ps_mt ) );
+
+  ps.minimize_truth_table = ps_mt.minimize_truth_table = true;
+  check_same_cuts( cut_enumeration<klut_network, true>( klut, ps ), cut_enumeration<klut_network, true>( klut, ps_mt ) );
+
+  const auto cuts = cut_enumeration<aig_network, false>( aig, ps_mt );
+  CHECK( cuts.total_cuts() == cut_enumeration<aig_network, false>( aig, ps ).total_cuts() );
+}
+
 TEST_CASE( "enumerate cuts for an AIG (small graph version)", "[fast_small_cut_enumeration]" )
 {
   aig_network aig;
@@ -329,3 +373,44 @@ TEST_CASE( "enumerate smaller cuts for an AIG (small graph version)", "[fast_sma
   CHECK( bitcut_to_vector( cuts.at( i4 )[1] ) == std::vector<uint32_t>{ 4, 5 } );
   CHECK( bitcut_to_vector( cuts.at( i4 )[2] ) == std::vector<uint32_t>{ 6 } );
 }
+
+template<uint32_t NumVars, class Ntk>
+void check_static_truth_tables( Ntk const& ntk, bool minimize )
+{
+  cut_enumeration_params ps;
+  ps.cut_size = NumVars;
+  ps.cut_limit = 12u;
+  ps.minimize_truth_table = minimize;
+
+  const auto cuts = cut_enumeration<Ntk, true>( ntk, ps );
+  const auto fast_cuts = fast_cut_enumeration<Ntk, NumVars, true>( ntk, ps );
+
+  REQUIRE( cuts.nodes_size() == fast_cuts.nodes_size() );
+  for ( auto i = 0u; i < cuts.nodes_size(); ++i )
+  {
+    REQUIRE( cuts.cuts( i ).size() == fast_cuts.cuts( i ).size() );
+    for ( auto j = 0u; j < cuts.cuts( i ).size(); ++j )
+    {
+      auto const& c1 = cuts.cuts( i )[j];
+      auto const& c2 = fast_cuts.cuts( i )[j];
+      CHECK( std::vector<uint32_t>( c1.begin(), c1.end() ) == std::vector<uint32_t>( c2.begin(), c2.end() ) );
+
+      kitty::static_truth_table<NumVars> tt;
+      kitty::extend_to_inplace( tt, cuts.truth_table( c1 ) );
+      CHECK( tt == fast_cuts.truth_table( c2 ) );
+    }
+  }
+}
+
+TEST_CASE( "static and dynamic cut truth tables agree", "[cut_enumeration]" )
+{
+  const auto aig = multiplier_network<aig_network>( 5u );
+  const auto klut = multiplier_network<klut_network>( 4u );
+
+  for ( auto minimize : {false, true} )
+  {
+    check_static_truth_tables<4u>( aig, minimize );
+    check_static_truth_tables<6u>( aig, minimize );
+    check_static_truth_tables<4u>( klut, minimize );
+  }
+}
@@ -0,0 +1,133 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/cut_manager.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+
+#include <kitty/operations.hpp>
+
+#include <vector>
+
+#include "../test_networks.hpp"
+
+using namespace mockturtle;
+
+template<class Ntk>
+void check_cut_manager()
+{
+  const auto ntk = multiplier_network<Ntk>( 5u );
+
+  cut_enumeration_params ps;
+  ps.cut_size = 4u;
+  ps.cut_limit = 8u;
+
+  cut_manager<Ntk, true> manager( ntk, ps );
+  CHECK( manager.num_dirty() == ntk.size() );
+  manager.update();
+  CHECK( manager.num_dirty() == 0u );
+  CHECK( manager.num_computed() == ntk.size() );
+
+  const auto cuts = cut_enumeration<Ntk, true>( ntk, ps );
+  ntk.foreach_node( [&]( auto const& n ) {
+    const auto index = ntk.node_to_index( n );
+    check_same_cut_set( cuts, cuts.cuts( index ), manager, manager.database().cuts( index ) );
+  } );
+}
+
+TEST_CASE( "cut manager computes the same cuts as cut enumeration", "[cut_manager]" )
+{
+  check_cut_manager<aig_network>();
+  check_cut_manager<mig_network>();
+}
+
+TEST_CASE( "cut manager after substitutions", "[cut_manager]" )
+{
+  auto aig = multiplier_network<aig_network>( 4u );
+
+  cut_enumeration_params ps;
+  ps.cut_size = 4u;
+  ps.cut_limit = 8u;
+
+  cut_manager<aig_network, true> manager( aig, ps );
+  manager.update();
+
+  /* several rounds: replace a gate with fanout by a new gate over two PIs */
+  std::vector<aig_network::signal> pis;
+  aig.foreach_pi( [&]( auto const& n ) { pis.push_back( aig.make_signal( n ) ); } );
+  for ( auto round = 0u; round < 4u; ++round )
+  {
+    aig_network::node target{};
+    uint32_t count{0u};
+    aig.foreach_gate( [&]( auto const& n ) {
+      if ( aig.fanout_size( n ) > 1u && count++ == 3u * round )
+      {
+        target = n;
+        return false;
+      }
+      return true;
+    } );
+    REQUIRE( target != 0u );
+
+    const auto g = aig.create_and( pis[round], !pis[round + 4u] );
+    CHECK( manager.is_dirty( aig.get_node( g ) ) );
+    const auto computed = manager.num_computed();
+    aig.substitute_node( target, g );
+
+    /* only the transitive fanout is out of date */
+    const auto num_dirty = manager.num_dirty();
+    CHECK( num_dirty > 1u );
+    CHECK( num_dirty < aig.num_gates() );
+    manager.update();
+    CHECK( manager.num_computed() - computed == num_dirty );
+  }
+
+  /* compare with all cuts computed from scratch */
+  cut_manager<aig_network, true> fresh( aig, ps );
+  aig.foreach_node( [&]( auto const& n ) {
+    if ( aig.is_dead( n ) )
+    {
+      return;
+    }
+    check_same_cut_set( manager, manager.cuts( n ), fresh, fresh.cuts( n ) );
+  } );
+}
+
+TEST_CASE( "cut manager with queries between substitutions", "[cut_manager]" )
+{
+  auto aig = multiplier_network<aig_network>( 4u );
+
+  cut_enumeration_params ps;
+  ps.cut_size = 4u;
+  ps.cut_limit = 8u;
+
+  /* cut sets are only requested, `update` is never called */
+  cut_manager<aig_network, true> manager( aig, ps );
+  std::vector<aig_network::signal> pis;
+  aig.foreach_pi( [&]( auto const& n ) { pis.push_back( aig.make_signal( n ) ); } );
+  for ( auto round = 0u; round < 8u; ++round )
+  {
+    aig.foreach_node( [&]( auto const& n ) {
+      manager.cuts( n );
+    } );
+    CHECK( manager.num_dirty() == 0u );
+
+    aig_network::node target{};
+    aig.foreach_gate( [&]( auto const& n ) {
+      if ( aig.fanout_size( n ) > 1u )
+      {
+        target = n;
+        return false;
+      }
+      return true;
+    } );
+    REQUIRE( target != 0u );
+    aig.substitute_node( target, aig.create_and( pis[round], !pis[( round + 1u ) % 8u] ) );
+    CHECK( manager.num_dirty() > 0u );
+  }
+
+  cut_manager<aig_network, true> fresh( aig, ps );
+  aig.foreach_po( [&]( auto const& f ) {
+    check_same_cut_set( manager, manager.cuts( aig.get_node( f ) ), fresh, fresh.cuts( aig.get_node( f ) ) );
+  } );
+}
@@ -0,0 +1,133 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/dont_cares.hpp>
+#include <mockturtle/algorithms/fault_simulation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+#include <vector>
+
+#include "../test_networks.hpp"
+
+using namespace mockturtle;
+
+/* simulates the patterns of `sim` with the values of one PI complemented */
+class flipped_pi_simulator
+{
+public:
+  flipped_pi_simulator( partial_simulator const& sim, uint32_t index )
+      : sim( sim ), index( index )
+  {
+  }
+
+  kitty::partial_truth_table compute_constant( bool value ) const
+  {
+    return sim.compute_constant( value );
+  }
+
+  kitty::partial_truth_table compute_pi( uint32_t i ) const
+  {
+    return i == index ? ~sim.compute_pi( i ) : sim.compute_pi( i );
+  }
+
+  kitty::partial_truth_table compute_not( kitty::partial_truth_table const& value ) const
+  {
+    return ~value;
+  }
+
+private:
+  partial_simulator const& sim;
+  uint32_t index;
+};
+
+template<class Ntk>
+void check_fault_simulation()
+{
+  Ntk ntk;
+  const auto [a, b] = create_multiplier( ntk, 4u );
+  ntk.create_and( a[0], b[1] ); /* dangling */
+
+  partial_simulator sim( ntk.num_pis(), 100 );
+  fault_simulator<Ntk> fsim( ntk, sim );
+  fsim.run();
+
+  fanout_view<Ntk> fntk{ntk};
+  uint32_t num_detected{0u};
+  auto const check = [&]( auto const& n ) {
+    unordered_node_map<kitty::partial_truth_table, fanout_view<Ntk>> tts( fntk );
+    auto const odc = observability_dont_cares( fntk, n, sim, tts, -1 );
+    CHECK( fsim.observability( n ) == ~odc );
+    CHECK( fsim.detecting_patterns( n, false ) == ( ~odc & fsim.value( n ) ) );
+    num_detected += fsim.is_detected( n, false ) ? 1u : 0u;
+    num_detected += fsim.is_detected( n, true ) ? 1u : 0u;
+  };
+  ntk.foreach_gate( check );
+  auto const pos = simulate<kitty::partial_truth_table>( ntk, sim );
+  ntk.foreach_pi( [&]( auto const& n, auto i ) {
+    kitty::partial_truth_table care( 100u );
+    auto const flipped = simulate<kitty::partial_truth_table>( ntk, flipped_pi_simulator( sim, i ) );
+    for ( auto j = 0u; j < pos.size(); ++j )
+    {
+      care |= pos[j] ^ flipped[j];
+    }
+    CHECK( fsim.observability( n ) == care );
+    num_detected += fsim.is_detected( n, false ) ? 1u : 0u;
+    num_detected += fsim.is_detected( n, true ) ? 1u : 0u;
+  } );
+
+  CHECK( fsim.num_faults() == 2u * ( ntk.num_pis() + ntk.num_gates() ) );
+  CHECK( fsim.num_detected_faults() == num_detected );
+
+  /* with a limit on the events, observability is under-approximated */
+  fault_simulation_params ps;
+  ps.max_events = 5u;
+  fault_simulation_stats st;
+  fault_simulator<Ntk> limited( ntk, sim, ps, &st );
+  limited.run();
+  CHECK( st.num_aborted_stems > 0u );
+  CHECK( limited.num_detected_faults() <= num_detected );
+  ntk.foreach_gate( [&]( auto const& n ) {
+    CHECK( kitty::is_const0( limited.observability( n ) & ~fsim.observability( n ) ) );
+  } );
+}
+
+TEST_CASE( "Fault simulation of multipliers", "[fault_simulation]" )
+{
+  check_fault_simulation<aig_network>();
+  check_fault_simulation<xag_network>();
+  check_fault_simulation<mig_network>();
+}
+
+TEST_CASE( "Fault simulation with reconvergent fanout", "[fault_simulation]" )
+{
+  xag_network xag;
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto f1 = xag.create_xor( a, b );
+  const auto f2 = xag.create_and( a, b );
+  const auto f3 = xag.create_or( a, b );
+  xag.create_po( xag.create_xor( f1, xag.create_xor( f2, f3 ) ) ); /* constant 0 */
+
+  partial_simulator sim( xag.num_pis(), 0 );
+  sim.add_pattern( {0, 0} );
+  sim.add_pattern( {0, 1} );
+  sim.add_pattern( {1, 0} );
+  sim.add_pattern( {1, 1} );
+
+  fault_simulation_stats st;
+  fault_simulator<xag_network> fsim( xag, sim, {}, &st );
+  fsim.run();
+
+  CHECK( st.num_stems == 2u );
+  CHECK( fsim.observability( xag.get_node( a ) ) == kitty::partial_truth_table( 4u ) );
+  CHECK( fsim.observability( xag.get_node( b ) ) == kitty::partial_truth_table( 4u ) );
+  CHECK( !fsim.is_detected( xag.get_node( a ), false ) );
+  CHECK( fsim.is_detected( xag.get_node( f1 ), false ) );
+  CHECK( fsim.is_detected( xag.get_node( f1 ), true ) );
+}
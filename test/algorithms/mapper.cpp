@@ -20,6 +20,8 @@
 #include <mockturtle/utils/tech_library.hpp>
 #include <mockturtle/views/binding_view.hpp>
 
+#include "../test_networks.hpp"
+
 using namespace mockturtle;
 
 std::string const test_library = "GATE   inv1    1 O=!a;            PIN * INV 1 999 0.9 0.3 0.9 0.3\n"
@@ -455,3 +457,31 @@ TEST_CASE( "Exact map with logic sharing", "[mapper]" )
   CHECK( res.num_pos() == 2 );
   CHECK( res.num_gates() == 4 );
 }
+
+TEST_CASE( "Map with given switching activities", "[mapper]" )
+{
+  std::vector<gate> gates;
+
+  std::istringstream in( test_library );
+  auto result = lorina::read_genlib( in, genlib_reader( gates ) );
+  CHECK( result == lorina::return_code::success );
+
+  tech_library<3> lib( gates );
+
+  const auto aig = multiplier_network<aig_network>( 4u );
+
+  map_params ps;
+  ps.eswp_rounds = 2u;
+  map_stats st1, st2;
+  binding_view<klut_network> luts1 = map( aig, lib, ps, &st1 );
+
+  switching_activity_params sps;
+  sps.num_patterns = ps.switching_activity_patterns;
+  sps.num_threads = 2u;
+  switching_activity_engine<aig_network> sw( aig, sps );
+  binding_view<klut_network> luts2 = map( aig, lib, sw.activities(), ps, &st2 );
+
+  CHECK( luts1.num_gates() == luts2.num_gates() );
+  CHECK( st1.area == st2.area );
+  CHECK( st1.power == st2.power );
+}
@@ -117,3 +117,37 @@ TEST_CASE( "With observability awareness", "[pattern_generation]" )
   /* the generated pattern should be either 000, 010, or 101 */
   CHECK( ( ( !kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) || ( kitty::get_bit( sim.compute_pi( 0 ), 3 ) && !kitty::get_bit( sim.compute_pi( 1 ), 3 ) && kitty::get_bit( sim.compute_pi( 2 ), 3 ) ) ) == true );
 }
+
+TEST_CASE( "Fault dropping and coverage", "[pattern_generation]" )
+{
+  xag_network xag;
+
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto c = xag.create_pi();
+
+  const auto f1 = xag.create_and( a, b );
+  const auto f2 = xag.create_and( f1, c );
+  const auto f3 = xag.create_and( !f1, !a );
+  const auto f4 = xag.create_xor( f2, f3 );
+  xag.create_po( f4 );
+
+  partial_simulator sim( xag.num_pis(), 0 );
+  sim.add_pattern( {0, 1, 1} );
+  sim.add_pattern( {1, 1, 0} );
+  sim.add_pattern( {1, 1, 1} );
+
+  pattern_generation_params ps;
+  ps.odc_levels = -1;
+  ps.fault_coverage = true;
+  pattern_generation_stats st;
+
+  pattern_generation( xag, sim, ps, &st );
+
+  CHECK( sim.num_bits() == 4 );
+  CHECK( st.num_dropped_nodes == 3 );
+  fault_simulator<xag_network> fsim( xag, sim );
+  fsim.run();
+  CHECK( st.num_faults == 2 * ( xag.num_pis() + xag.num_gates() ) );
+  CHECK( st.num_detected_faults == fsim.num_detected_faults() );
+}
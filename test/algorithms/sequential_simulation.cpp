@@ -0,0 +1,129 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/sequential_simulation.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+#include <vector>
+
+using namespace mockturtle;
+
+TEST_CASE( "simulate a toggling register", "[sequential_simulation]" )
+{
+  aig_network aig;
+  const auto a = aig.create_ro();
+  const auto b = aig.create_ro();
+  aig.create_po( a );
+  aig.create_po( aig.create_and( a, b ) );
+  aig.create_ri( !a, 0 );
+  aig.create_ri( b, 1 );
+
+  sequential_simulation_params ps;
+  ps.num_words = 2u;
+  ps.count_toggles = true;
+
+  std::vector<bool> expected{false, true, false, true, false};
+  simulate_sequential(
+      aig, 5u, random_pattern_source(), [&]( auto const& sim ) {
+        const auto cycle = sim.cycle() - 1u;
+        CHECK( sim.po_value( 0u ).num_bits() == 128u );
+        CHECK( kitty::count_ones( sim.po_value( 0u ) ) == ( expected[cycle] ? 128u : 0u ) );
+        CHECK( kitty::count_ones( sim.po_value( 1u ) ) == ( expected[cycle] ? 128u : 0u ) );
+        CHECK( kitty::count_ones( sim.value( aig.get_node( b ) ) ) == 128u );
+      },
+      ps );
+
+  sequential_simulator<aig_network> sim( aig, ps );
+  for ( auto i = 0u; i < 5u; ++i )
+  {
+    sim.step( random_pattern_source() );
+  }
+  CHECK( sim.cycle() == 5u );
+  CHECK( sim.toggles( aig.get_node( a ) ) == 4u * 128u );
+  CHECK( sim.toggles( aig.get_node( b ) ) == 0u );
+
+  sim.reset();
+  CHECK( sim.cycle() == 0u );
+  CHECK( sim.toggles( aig.get_node( a ) ) == 0u );
+}
+
+TEST_CASE( "simulate a shift register with random inputs", "[sequential_simulation]" )
+{
+  klut_network klut;
+  const auto x = klut.create_pi();
+  const auto r1 = klut.create_ro();
+  const auto r2 = klut.create_ro();
+  klut.create_po( r2 );
+  klut.create_po( klut.create_xor( x, r1 ) );
+  klut.create_ri( x, 0 );
+  klut.create_ri( r1, 0 );
+
+  sequential_simulation_params ps;
+  ps.num_words = 3u;
+
+  random_pattern_source source( 5u );
+  std::vector<kitty::partial_truth_table> inputs;
+  simulate_sequential(
+      klut, 6u, source, [&]( auto const& sim ) {
+        const auto cycle = sim.cycle() - 1u;
+        kitty::partial_truth_table tt( 3u * 64u );
+        source( 0u, uint64_t( cycle ) * 3u, tt );
+        inputs.push_back( tt );
+
+        const auto delayed1 = cycle >= 1u ? inputs[cycle - 1u] : kitty::partial_truth_table( 3u * 64u );
+        const auto delayed2 = cycle >= 2u ? inputs[cycle - 2u] : kitty::partial_truth_table( 3u * 64u );
+        CHECK( sim.value( klut.get_node( x ) ) == tt );
+        CHECK( sim.po_value( 0u ) == delayed2 );
+        CHECK( sim.po_value( 1u ) == ( tt ^ delayed1 ) );
+      },
+      ps );
+}
+
+TEST_CASE( "random initial register values", "[sequential_simulation]" )
+{
+  aig_network aig;
+  const auto a = aig.create_ro();
+  aig.create_po( a );
+  aig.create_ri( a, 2 );
+
+  sequential_simulation_params ps;
+  ps.num_words = 4u;
+
+  kitty::partial_truth_table first;
+  simulate_sequential(
+      aig, 3u, random_pattern_source(), [&]( auto const& sim ) {
+        if ( sim.cycle() == 1u )
+        {
+          first = sim.po_value( 0u );
+          CHECK( kitty::count_ones( first ) > 0u );
+          CHECK( kitty::count_ones( first ) < 256u );
+        }
+        else
+        {
+          CHECK( sim.po_value( 0u ) == first );
+        }
+      },
+      ps );
+}
+
+TEST_CASE( "random initial register values are independent of the inputs", "[sequential_simulation]" )
+{
+  aig_network aig;
+  const auto x = aig.create_pi();
+  const auto a = aig.create_ro();
+  aig.create_po( x );
+  aig.create_po( a );
+  aig.create_ri( a, 2 );
+
+  /* the inputs use the same seed as the registers */
+  sequential_simulation_params ps;
+  ps.num_words = 4u;
+  sequential_simulator sim( aig, ps );
+  sim.step( random_pattern_source( ps.seed ) );
+  CHECK( sim.po_value( 0u ) != sim.po_value( 1u ) );
+  CHECK( sim.po_value( 0u ) != ~sim.po_value( 1u ) );
+}
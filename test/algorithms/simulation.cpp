@@ -2,10 +2,14 @@
 
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
 #include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
 
 #include <kitty/static_truth_table.hpp>
 
+#include "../test_networks.hpp"
+
 using namespace mockturtle;
 
 TEST_CASE( "Simulate XOR AIG circuit with Booleans", "[simulation]" )
@@ -192,6 +196,221 @@ TEST_CASE( "Incremental simulation with partial_simulator", "[simulation]" )
   CHECK( ( aig.is_complemented( f5 ) ? ~node_to_value[f5] : node_to_value[f5] ) == kitty::partial_truth_table( 65 ) );
 }
 
+TEST_CASE( "Simulate MAJ and XOR3 gates with complemented fanins with partial_simulator", "[simulation]" )
+{
+  xmg_network xmg;
+
+  const auto a = xmg.create_pi();
+  const auto b = xmg.create_pi();
+  const auto c = xmg.create_pi();
+  const auto f1 = xmg.create_maj( a, !b, c );
+  const auto f2 = xmg.create_xor3( !f1, b, c );
+  const auto f3 = xmg.create_and( f2, !a );
+  const auto f4 = xmg.create_maj( !f3, f1, !f2 );
+  xmg.create_po( f4 );
+
+  /* enough patterns to use vector words and a partial last word */
+  partial_simulator sim( 3u, 1000u );
+  auto const ta = sim.compute_pi( 0u ), tb = sim.compute_pi( 1u ), tc = sim.compute_pi( 2u );
+  const auto maj = []( auto const& x, auto const& y, auto const& z ) { return ( x & y ) | ( x & z ) | ( y & z ); };
+
+  const auto e1 = maj( ta, ~tb, tc );
+  const auto e2 = ~e1 ^ tb ^ tc;
+  const auto e3 = e2 & ~ta;
+  const auto e4 = maj( ~e3, e1, ~e2 );
+
+  unordered_node_map<kitty::partial_truth_table, xmg_network> node_to_value( xmg );
+  simulate_nodes( xmg, node_to_value, sim );
+
+  CHECK( ( xmg.is_complemented( f1 ) ? ~node_to_value[f1] : node_to_value[f1] ) == e1 );
+  CHECK( ( xmg.is_complemented( f2 ) ? ~node_to_value[f2] : node_to_value[f2] ) == e2 );
+  CHECK( ( xmg.is_complemented( f3 ) ? ~node_to_value[f3] : node_to_value[f3] ) == e3 );
+  CHECK( ( xmg.is_complemented( f4 ) ? ~node_to_value[f4] : node_to_value[f4] ) == e4 );
+
+  const auto values = simulate_nodes<kitty::partial_truth_table>( xmg, sim );
+  CHECK( ( xmg.is_complemented( f4 ) ? ~values[f4] : values[f4] ) == e4 );
+}
+
+TEST_CASE( "Simulate with several threads", "[simulation]" )
+{
+  const auto xmg = multiplier_network<xmg_network>( 6u );
+
+  klut_network klut;
+  const auto x = klut.create_pi();
+  const auto y = klut.create_pi();
+  const auto z = klut.create_pi();
+  const auto g = klut.create_maj( x, klut.create_xor( y, z ), klut.create_not( x ) );
+  klut.create_po( klut.create_ite( g, y, z ) );
+
+  partial_simulator sim( xmg.num_pis(), 1000u );
+  const auto expected = simulate_nodes<kitty::partial_truth_table>( xmg, sim );
+  partial_simulator lsim( klut.num_pis(), 1000u );
+  const auto lexpected = simulate_nodes<kitty::partial_truth_table>( klut, lsim );
+  const auto texpected = simulate_nodes<kitty::dynamic_truth_table>( xmg, default_simulator<kitty::dynamic_truth_table>( xmg.num_pis() ) );
+
+  for ( auto partition_words : {true, false} )
+  {
+    parallel_simulation_params ps;
+    ps.num_threads = 3u;
+    ps.partition_words = partition_words;
+
+    const auto values = simulate_nodes_parallel<kitty::partial_truth_table>( xmg, sim, ps );
+    xmg.foreach_node( [&]( auto const& n ) {
+      CHECK( values[n] == expected[n] );
+    } );
+
+    const auto lvalues = simulate_nodes_parallel<kitty::partial_truth_table>( klut, lsim, ps );
+    klut.foreach_node( [&]( auto const& n ) {
+      CHECK( lvalues[n] == lexpected[n] );
+    } );
+  }
+
+  parallel_simulation_params ps;
+  ps.num_threads = 4u;
+  const auto tvalues = simulate_nodes_parallel<kitty::dynamic_truth_table>( xmg, default_simulator<kitty::dynamic_truth_table>( xmg.num_pis() ), ps );
+  xmg.foreach_node( [&]( auto const& n ) {
+    CHECK( tvalues[n] == texpected[n] );
+  } );
+}
+
+TEST_CASE( "Simulate patterns in chunks", "[simulation]" )
+{
+  const auto xag = multiplier_network<xag_network>( 6u );
+
+  /* all patterns at once as reference */
+  const uint64_t num_patterns = 1000u;
+  random_pattern_source source( 5u );
+  std::vector<kitty::partial_truth_table> patterns( xag.num_pis(), kitty::partial_truth_table( num_patterns ) );
+  for ( auto i = 0u; i < patterns.size(); ++i )
+  {
+    source( i, 0u, patterns[i] );
+  }
+  partial_simulator sim( patterns );
+  const auto expected = simulate_nodes<kitty::partial_truth_table>( xag, sim );
+
+  for ( auto chunk_words : {1u, 3u, 64u} )
+  {
+    chunked_simulation_params ps;
+    ps.chunk_words = chunk_words;
+
+    /* keep the PO values and count the ones of all nodes */
+    std::vector<kitty::partial_truth_table> po_values( xag.num_pos() );
+    std::vector<uint64_t> ones( xag.size() );
+    simulate_chunks(
+        xag, num_patterns, source, [&]( auto const& node_to_value, uint64_t first, uint32_t num_bits ) {
+          CHECK( first == po_values[0].num_bits() );
+          CHECK( num_bits == std::min<uint64_t>( chunk_words * 64u, num_patterns - first ) );
+          xag.foreach_po( [&]( auto const& f, auto i ) {
+            auto const& tt = node_to_value[f];
+            for ( auto j = 0u; j < num_bits; ++j )
+            {
+              po_values[i].add_bit( kitty::get_bit( tt, j ) );
+            }
+          } );
+          xag.foreach_node( [&]( auto const& n ) {
+            ones[n] += kitty::count_ones( node_to_value[n] );
+          } );
+        },
+        ps );
+
+    xag.foreach_po( [&]( auto const& f, auto i ) {
+      CHECK( po_values[i] == expected[f] );
+    } );
+    xag.foreach_node( [&]( auto const& n ) {
+      CHECK( ones[n] == kitty::count_ones( expected[n] ) );
+    } );
+  }
+
+  /* patterns given as truth tables */
+  std::vector<kitty::partial_truth_table> po_values( xag.num_pos() );
+  chunked_simulation_params ps;
+  ps.chunk_words = 2u;
+  simulate_chunks(
+      xag, num_patterns, partial_truth_table_pattern_source( patterns ), [&]( auto const& node_to_value, uint64_t, uint32_t num_bits ) {
+        xag.foreach_po( [&]( auto const& f, auto i ) {
+          for ( auto j = 0u; j < num_bits; ++j )
+          {
+            po_values[i].add_bit( kitty::get_bit( node_to_value[f], j ) );
+          }
+        } );
+      },
+      ps );
+  xag.foreach_po( [&]( auto const& f, auto i ) {
+    CHECK( po_values[i] == expected[f] );
+  } );
+}
+
+TEST_CASE( "Simulate outputs with reused values", "[simulation]" )
+{
+  /* a deep chain needs only a few values at a time */
+  xag_network xag;
+  std::vector<xag_network::signal> pis( 8u );
+  std::generate( pis.begin(), pis.end(), [&]() { return xag.create_pi(); } );
+  auto f = pis[0];
+  for ( auto i = 0u; i < 200u; ++i )
+  {
+    f = ( i % 3u == 0u ) ? xag.create_xor( f, pis[i % 8u] ) : xag.create_and( !f, pis[i % 8u] );
+    if ( i % 50u == 0u )
+    {
+      xag.create_po( f );
+    }
+  }
+  xag.create_and( f, pis[1] ); /* dangling */
+  xag.create_po( !f );
+
+  default_simulator<kitty::dynamic_truth_table> tsim( xag.num_pis() );
+  const auto tts = simulate_nodes<kitty::dynamic_truth_table>( xag, tsim );
+  std::vector<kitty::dynamic_truth_table> tbuffers;
+  const auto tpos = detail::simulate_outputs<kitty::dynamic_truth_table>( xag, tsim, tbuffers );
+  CHECK( tbuffers.size() < 20u );
+  CHECK( simulate<kitty::dynamic_truth_table>( xag, tsim ) == tpos );
+
+  partial_simulator psim( xag.num_pis(), 300u );
+  const auto pvalues = simulate_nodes<kitty::partial_truth_table>( xag, psim );
+  std::vector<kitty::partial_truth_table> pbuffers;
+  const auto ppos = detail::simulate_outputs<kitty::partial_truth_table>( xag, psim, pbuffers );
+  CHECK( pbuffers.size() < 20u );
+  xag.foreach_po( [&]( auto const& f, auto i ) {
+    CHECK( tpos[i] == ( xag.is_complemented( f ) ? ~tts[f] : tts[f] ) );
+    CHECK( ppos[i] == ( xag.is_complemented( f ) ? ~pvalues[f] : pvalues[f] ) );
+  } );
+
+  /* uses by dangling gates do not keep values alive */
+  xag_network dxag;
+  std::vector<xag_network::signal> dpis( 16u ), inner;
+  std::generate( dpis.begin(), dpis.end(), [&]() { return dxag.create_pi(); } );
+  for ( auto i = 0u; i < dpis.size(); i += 2u )
+  {
+    inner.push_back( dxag.create_and( dpis[i], dpis[i + 1u] ) );
+  }
+  dxag.create_po( dxag.create_xor( dpis[0], dpis[1] ) );
+  for ( auto const& g : inner )
+  {
+    dxag.create_and( g, !dpis[2] ); /* dangling */
+  }
+
+  default_simulator<kitty::dynamic_truth_table> dsim( dxag.num_pis() );
+  std::vector<kitty::dynamic_truth_table> dbuffers;
+  const auto dpos = detail::simulate_outputs<kitty::dynamic_truth_table>( dxag, dsim, dbuffers );
+  CHECK( dbuffers.size() == 3u );
+  CHECK( dpos == simulate<kitty::dynamic_truth_table>( dxag, dsim ) );
+
+  /* k-LUT network */
+  klut_network klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+  const auto g = klut.create_maj( a, klut.create_xor( b, c ), klut.create_not( a ) );
+  klut.create_po( klut.create_ite( g, b, c ) );
+  klut.create_po( g );
+  default_simulator<kitty::dynamic_truth_table> lsim( klut.num_pis() );
+  const auto ltts = simulate_nodes<kitty::dynamic_truth_table>( klut, lsim );
+  const auto lpos = simulate<kitty::dynamic_truth_table>( klut, lsim );
+  klut.foreach_po( [&]( auto const& f, auto i ) {
+    CHECK( lpos[i] == ltts[f] );
+  } );
+}
+
 TEST_CASE( "Bit packing", "[simulation]" )
 {
   std::vector<kitty::partial_truth_table> pats( 5 );
@@ -0,0 +1,101 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/simulation_program.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/networks/xmg.hpp>
+
+#include <kitty/dynamic_truth_table.hpp>
+#include <kitty/partial_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include "../test_networks.hpp"
+
+using namespace mockturtle;
+
+template<class Ntk>
+void check_simulation_program()
+{
+  Ntk ntk;
+  const auto [a, b] = create_multiplier( ntk, 4u );
+  (void)b;
+  ntk.create_po( !ntk.po_at( 0u ) );
+  ntk.create_po( ntk.get_constant( true ) );
+  ntk.create_po( a[1] );
+  ntk.create_and( !a[0], a[3] ); /* dangling */
+
+  simulation_program program = compile_simulation( ntk );
+  CHECK( program.num_pis() == ntk.num_pis() );
+  CHECK( program.num_pos() == ntk.num_pos() );
+  CHECK( program.instructions().size() < ntk.num_gates() );
+  CHECK( program.num_slots() < ntk.size() );
+
+  default_simulator<kitty::dynamic_truth_table> tsim( ntk.num_pis() );
+  CHECK( program.simulate<kitty::dynamic_truth_table>( tsim ) == simulate<kitty::dynamic_truth_table>( ntk, tsim ) );
+
+  default_simulator<kitty::static_truth_table<8u>> ssim;
+  CHECK( program.simulate<kitty::static_truth_table<8u>>( ssim ) == simulate<kitty::static_truth_table<8u>>( ntk, ssim ) );
+
+  for ( auto num_patterns : {64u, 1000u} )
+  {
+    partial_simulator psim( ntk.num_pis(), num_patterns );
+    CHECK( program.simulate<kitty::partial_truth_table>( psim ) == simulate<kitty::partial_truth_table>( ntk, psim ) );
+  }
+
+  for ( auto word : {0x5au, 0xffu, 0x13u} )
+  {
+    std::vector<bool> assignment( ntk.num_pis() );
+    for ( auto i = 0u; i < assignment.size(); ++i )
+    {
+      assignment[i] = ( word >> i ) & 1u;
+    }
+    default_simulator<bool> bsim( assignment );
+    CHECK( program.simulate<bool>( bsim ) == simulate<bool>( ntk, bsim ) );
+  }
+}
+
+TEST_CASE( "compile and run simulation programs", "[simulation_program]" )
+{
+  check_simulation_program<aig_network>();
+  check_simulation_program<xag_network>();
+  check_simulation_program<mig_network>();
+  check_simulation_program<xmg_network>();
+}
+
+TEST_CASE( "run simulation program on words", "[simulation_program]" )
+{
+  xag_network xag;
+  const auto a = xag.create_pi();
+  const auto b = xag.create_pi();
+  const auto c = xag.create_pi();
+  xag.create_po( xag.create_xor( xag.create_and( a, !b ), c ) );
+  xag.create_po( !xag.create_and( b, c ) );
+
+  auto program = compile_simulation( xag );
+
+  /* two words per input */
+  std::vector<uint64_t> inputs{0xf0f0, 0x1, 0xff00, 0x3, 0xcccc, 0x2};
+  std::vector<uint64_t> outputs( 4u );
+  program.run( inputs.data(), outputs.data(), 2u );
+  CHECK( outputs[0] == ( ( UINT64_C( 0xf0f0 ) & ~UINT64_C( 0xff00 ) ) ^ UINT64_C( 0xcccc ) ) );
+  CHECK( outputs[1] == ( ( UINT64_C( 0x1 ) & ~UINT64_C( 0x3 ) ) ^ UINT64_C( 0x2 ) ) );
+  CHECK( outputs[2] == ~( UINT64_C( 0xff00 ) & UINT64_C( 0xcccc ) ) );
+  CHECK( outputs[3] == ~( UINT64_C( 0x3 ) & UINT64_C( 0x2 ) ) );
+}
+
+TEST_CASE( "reject networks that cannot be compiled", "[simulation_program]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto r = aig.create_ro();
+  const auto f = aig.create_and( a, r );
+  aig.create_po( f );
+  aig.create_ri( f );
+
+  CHECK_THROWS_AS( compile_simulation( aig ), std::invalid_argument );
+}
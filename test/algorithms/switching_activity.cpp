@@ -0,0 +1,133 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/algorithms/switching_activity.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/mig.hpp>
+
+#include <kitty/bit_operations.hpp>
+#include <kitty/partial_truth_table.hpp>
+
+#include <vector>
+
+#include "../test_networks.hpp"
+
+using namespace mockturtle;
+
+/* counts the ones of all nodes with the same random patterns */
+template<class Ntk>
+node_map<uint64_t, Ntk> reference_ones( Ntk const& ntk, uint32_t num_patterns, uint64_t seed )
+{
+  std::vector<kitty::partial_truth_table> patterns( ntk.num_pis(), kitty::partial_truth_table( num_patterns ) );
+  random_pattern_source source( seed );
+  for ( auto i = 0u; i < patterns.size(); ++i )
+  {
+    source( i, 0u, patterns[i] );
+  }
+
+  node_map<uint64_t, Ntk> ones( ntk, 0u );
+  const auto tts = simulate_nodes<kitty::partial_truth_table>( ntk, partial_simulator( patterns ) );
+  ntk.foreach_node( [&]( auto const& n ) {
+    ones[n] = ntk.is_constant( n ) ? 0u : kitty::count_ones( tts[n] );
+  } );
+  return ones;
+}
+
+template<class Ntk>
+void check_switching_activity()
+{
+  const auto ntk = multiplier_network<Ntk>( 6u );
+
+  switching_activity_params ps;
+  ps.num_patterns = 1000u;
+  ps.chunk_words = 3u;
+  ps.seed = 7u;
+  const auto ones = reference_ones( ntk, ps.num_patterns, ps.seed );
+
+  for ( auto num_threads : {1u, 4u} )
+  {
+    ps.num_threads = num_threads;
+    switching_activity_engine<Ntk> sw( ntk, ps );
+    CHECK( sw.num_dirty() == ntk.size() );
+
+    const auto activities = sw.activities();
+    CHECK( sw.num_dirty() == 0u );
+    ntk.foreach_node( [&]( auto const& n ) {
+      CHECK( sw.num_ones( n ) == ones[n] );
+      const float p = static_cast<float>( ones[n] ) / ps.num_patterns;
+      CHECK( activities[ntk.node_to_index( n )] == Approx( 2.0f * p * ( 1.0f - p ) ) );
+    } );
+  }
+}
+
+TEST_CASE( "Switching activity of multipliers", "[switching_activity]" )
+{
+  check_switching_activity<aig_network>();
+  check_switching_activity<mig_network>();
+  check_switching_activity<klut_network>();
+}
+
+TEST_CASE( "Incremental switching activity after substitution", "[switching_activity]" )
+{
+  aig_network aig;
+  std::vector<aig_network::signal> a( 4u ), b( 4u );
+  std::generate( a.begin(), a.end(), [&]() { return aig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return aig.create_pi(); } );
+  auto carry = aig.get_constant( false );
+  auto outputs = a;
+  carry_ripple_adder_inplace( aig, outputs, b, carry );
+  for ( auto const& f : outputs )
+  {
+    aig.create_po( f );
+  }
+  aig.create_po( carry );
+
+  switching_activity_params ps;
+  ps.num_patterns = 512u;
+  switching_activity_engine<aig_network> sw( aig, ps );
+  sw.update();
+  CHECK( sw.num_dirty() == 0u );
+
+  /* replace the first carry by a new gate: only its transitive fanout is out of date */
+  aig_network::node first_carry{};
+  aig.foreach_gate( [&]( auto const& n ) {
+    if ( aig.fanout_size( n ) > 1u )
+    {
+      first_carry = n;
+      return false;
+    }
+    return true;
+  } );
+  const auto g = aig.create_and( a[0], b[3] );
+  CHECK( sw.num_dirty() == 1u );
+  aig.substitute_node( first_carry, g );
+  CHECK( sw.num_dirty() > 1u );
+  CHECK( sw.num_dirty() < aig.num_gates() );
+
+  /* the network is no longer topologically sorted, compare with a new engine */
+  switching_activity_engine<aig_network> fresh( aig, ps );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( sw.num_ones( n ) == fresh.num_ones( n ) );
+  } );
+  CHECK( sw.num_dirty() == 0u );
+}
+
+TEST_CASE( "Switching activity with register outputs", "[switching_activity]" )
+{
+  aig_network aig;
+  const auto x = aig.create_pi();
+  const auto r = aig.create_ro();
+  const auto g = aig.create_xor( x, r );
+  aig.create_po( g );
+  aig.create_ri( !r );
+
+  switching_activity_params ps;
+  ps.num_patterns = 1024u;
+  switching_activity_engine<aig_network> sw( aig, ps );
+
+  /* register outputs have their own random patterns */
+  CHECK( sw.num_ones( aig.get_node( g ) ) > 384u );
+  CHECK( sw.num_ones( aig.get_node( g ) ) < 640u );
+}
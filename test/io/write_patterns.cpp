@@ -1,9 +1,16 @@
 #include <catch.hpp>
 
+#include <fstream>
 #include <sstream>
+#include <stdexcept>
+#include <string>
 
 #include <mockturtle/io/write_patterns.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/utils/mapped_patterns.hpp>
+
+#include <kitty/bit_operations.hpp>
 
 using namespace mockturtle;
 
@@ -30,3 +37,78 @@ TEST_CASE( "write patterns", "[write_patterns]" )
                       "0d4\n"
                       "19a\n" );
 }
+
+TEST_CASE( "write and map binary patterns", "[write_patterns]" )
+{
+  partial_simulator sim( 5, 200 );
+  write_binary_patterns( sim, "patterns.bin" );
+  CHECK( is_binary_patterns_file( "patterns.bin" ) );
+
+  partial_simulator mapped( "patterns.bin" );
+  CHECK( mapped.num_bits() == 200u );
+  CHECK( mapped.get_patterns() == sim.get_patterns() );
+
+  partial_simulator truncated( "patterns.bin", 70u );
+  CHECK( truncated.num_bits() == 70u );
+  auto expected = sim.compute_pi( 3u );
+  expected.resize( 70u );
+  CHECK( truncated.compute_pi( 3u ) == expected );
+
+  /* a read-only mapped file is copied into memory when patterns are added */
+  mapped.add_pattern( {1, 1, 1, 1, 1} );
+  CHECK( mapped.num_bits() == 201u );
+  CHECK( kitty::get_bit( mapped.compute_pi( 4u ), 200u ) );
+  CHECK( mapped_patterns( "patterns.bin" ).num_patterns() == 200u );
+
+  /* a file with a truncated header is rejected */
+  {
+    std::ifstream in( "patterns.bin", std::ifstream::binary );
+    std::string prefix( 40u, '\0' );
+    in.read( &prefix[0], prefix.size() );
+    std::ofstream out( "patterns.bin", std::ofstream::binary | std::ofstream::trunc );
+    out.write( prefix.data(), prefix.size() );
+  }
+  CHECK( is_binary_patterns_file( "patterns.bin" ) );
+  CHECK( !mapped_patterns( "patterns.bin" ).is_open() );
+  CHECK_THROWS_AS( partial_simulator( "patterns.bin" ), std::runtime_error );
+}
+
+TEST_CASE( "append counter-examples to a binary pattern file", "[write_patterns]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  aig.create_po( aig.create_and( a, b ) );
+
+  {
+    auto file = std::make_shared<mapped_patterns>( "cex.bin", aig.num_pis() );
+    CHECK( file->capacity() == 64u );
+
+    partial_simulator sim( file );
+    for ( auto i = 0u; i < 100u; ++i )
+    {
+      sim.add_pattern( {i % 2u == 0u, i % 3u == 0u} );
+    }
+    CHECK( sim.num_bits() == 100u );
+    CHECK( file->num_patterns() == 100u );
+    CHECK( file->capacity() == 128u );
+
+    const auto tts = simulate<kitty::partial_truth_table>( aig, sim );
+    CHECK( kitty::count_ones( tts[0] ) == 17u );
+  }
+
+  partial_simulator reloaded( "cex.bin" );
+  CHECK( reloaded.num_bits() == 100u );
+  for ( auto i = 0u; i < 100u; ++i )
+  {
+    CHECK( kitty::get_bit( reloaded.compute_pi( 0u ), i ) == ( i % 2u == 0u ) );
+    CHECK( kitty::get_bit( reloaded.compute_pi( 1u ), i ) == ( i % 3u == 0u ) );
+  }
+
+  std::ostringstream out;
+  write_patterns( reloaded, out );
+  std::istringstream in( out.str() );
+  std::string line;
+  std::getline( in, line );
+  CHECK( line.size() == 25u );
+}
@@ -1,5 +1,9 @@
 #include <catch.hpp>
 
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
 #include <mockturtle/algorithms/cleanup.hpp>
 #include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/aig.hpp>
@@ -932,3 +936,263 @@ TEST_CASE( "substitute multiple nodes", "[aig]" )
     }
   });
 }
+
+TEST_CASE( "substitute nodes with fanout index in AIGs", "[aig]" )
+{
+  aig_network aig, ref;
+  CHECK( !aig.has_fanout_index() );
+  aig.enable_fanout_index();
+  CHECK( aig.has_fanout_index() );
+
+  for ( auto* ntk : {&aig, &ref} )
+  {
+    const auto x1 = ntk->create_pi();
+    const auto x2 = ntk->create_pi();
+    const auto x3 = ntk->create_pi();
+    const auto x4 = ntk->create_pi();
+
+    const auto f1 = ntk->create_and( x1, x2 );
+    const auto f2 = ntk->create_and( x3, x4 );
+    const auto f3 = ntk->create_and( x1, x3 );
+    const auto f4 = ntk->create_and( f1, f2 );
+    const auto f5 = ntk->create_and( f3, f4 );
+    const auto f6 = ntk->create_and( !f1, x4 );
+
+    ntk->create_po( f5 );
+    ntk->create_po( f6 );
+  }
+
+  const auto check_fanout_index = [&]() {
+    aig.foreach_node( [&]( auto const& n ) {
+      std::vector<uint64_t> fanouts;
+      aig.foreach_gate( [&]( auto const& g ) {
+        aig.foreach_fanin( g, [&]( auto const& f ) {
+          if ( aig.get_node( f ) == n )
+          {
+            fanouts.emplace_back( g );
+          }
+        } );
+      } );
+      CHECK( aig._storage->fanout_index.parents( n ) == fanouts );
+    } );
+  };
+
+  check_fanout_index();
+  CHECK( aig._storage->fanout_index.parents( 5u ) == std::vector<uint64_t>{8u, 10u} );
+
+  /* x2 = x3 makes f1 structurally equal to f3 */
+  aig.substitute_node( 2u, aig.make_signal( 3u ) );
+  ref.substitute_node( 2u, ref.make_signal( 3u ) );
+  check_fanout_index();
+  CHECK( aig.num_gates() == ref.num_gates() );
+  CHECK( aig.is_dead( 5u ) );
+  CHECK( simulate<kitty::static_truth_table<4u>>( aig ) == simulate<kitty::static_truth_table<4u>>( ref ) );
+
+  /* take out f4 by replacing it with a complemented input */
+  aig.substitute_node( 8u, !aig.make_signal( 4u ) );
+  ref.substitute_node( 8u, !ref.make_signal( 4u ) );
+  check_fanout_index();
+  CHECK( aig.num_gates() == ref.num_gates() );
+  CHECK( aig.is_dead( 8u ) );
+  CHECK( aig.is_dead( 6u ) );
+  CHECK( simulate<kitty::static_truth_table<4u>>( aig ) == simulate<kitty::static_truth_table<4u>>( ref ) );
+
+  aig.disable_fanout_index();
+  CHECK( !aig.has_fanout_index() );
+  CHECK( aig._storage->fanout_index.fanouts.num_bytes() == 0u );
+}
+
+TEST_CASE( "substitute chains of nodes in bulk", "[aig]" )
+{
+  using node = aig_network::node;
+  using signal = aig_network::signal;
+
+  aig_network aig;
+  auto const x1 = aig.create_pi();
+  auto const x2 = aig.create_pi();
+  auto const x3 = aig.create_pi();
+
+  auto const n4 = aig.create_and( x1, x2 );
+  auto const n5 = aig.create_and( n4, x3 );
+  auto const n6 = aig.create_and( n5, x1 );
+  auto const n7 = aig.create_and( !n6, x2 );
+
+  aig.create_po( n5 );
+  aig.create_po( n7 );
+
+  /* n5 is replaced by n4, which is replaced by x1 */
+  auto const num_rewritten = aig.substitute_nodes( std::list<std::pair<node, signal>>{
+      {aig.get_node( n5 ), n4},
+      {aig.get_node( n4 ), x1}
+    } );
+
+  /* n6 collapses into x1 and n7 is rewritten to use !x1 */
+  CHECK( num_rewritten == 1u );
+  CHECK( aig.num_gates() == 1u );
+  CHECK( aig.is_dead( aig.get_node( n4 ) ) );
+  CHECK( aig.is_dead( aig.get_node( n5 ) ) );
+  CHECK( aig.is_dead( aig.get_node( n6 ) ) );
+  CHECK( !aig.is_dead( aig.get_node( n7 ) ) );
+  CHECK( aig.fanout_size( aig.get_node( x1 ) ) == 2u );
+  CHECK( aig.fanout_size( aig.get_node( x2 ) ) == 1u );
+  CHECK( aig.fanout_size( aig.get_node( x3 ) ) == 0u );
+
+  CHECK( aig.po_at( 0 ) == x1 );
+  CHECK( aig.po_at( 1 ) == n7 );
+  aig.foreach_fanin( aig.get_node( n7 ), [&]( auto const& f, auto i ) {
+    CHECK( f == ( i == 0 ? !x1 : x2 ) );
+  } );
+}
+
+TEST_CASE( "create and use a compact AIG", "[aig]" )
+{
+  CHECK( sizeof( compact_aig_storage::node_type ) < sizeof( aig_storage::node_type ) );
+  CHECK( is_network_type_v<compact_aig_network> );
+  CHECK( has_create_and_v<compact_aig_network> );
+  CHECK( has_substitute_node_v<compact_aig_network> );
+  CHECK( compact_aig_storage::node_type::pointer_type::max_index == ( UINT64_C( 1 ) << 31 ) - 1u );
+  CHECK( aig_storage::node_type::pointer_type::max_index == ( UINT64_C( 1 ) << 63 ) - 1u );
+
+  compact_aig_network aig;
+  const auto x1 = aig.create_pi();
+  const auto x2 = aig.create_pi();
+  const auto x3 = aig.create_pi();
+
+  const auto f1 = aig.create_and( x1, !x2 );
+  const auto f2 = aig.create_and( !x1, x2 );
+  const auto f3 = aig.create_or( f1, f2 );
+  const auto f4 = aig.create_maj( x1, x2, x3 );
+  aig.create_po( f3 );
+  aig.create_po( !f4 );
+
+  CHECK( aig.num_gates() == 7u );
+  CHECK( aig.create_and( !x2, x1 ) == f1 );
+  CHECK( aig.is_complemented( f3 ) );
+  aig.foreach_fanin( aig.get_node( f1 ), [&]( auto const& f, auto i ) {
+    CHECK( f == ( i == 0 ? x1 : !x2 ) );
+  } );
+
+  auto tts = simulate<kitty::static_truth_table<3u>>( aig );
+  CHECK( tts[0]._bits == 0x66 );
+  CHECK( tts[1]._bits == 0x17 );
+
+  aig.substitute_node( aig.get_node( x3 ), aig.get_constant( true ) );
+  tts = simulate<kitty::static_truth_table<3u>>( aig );
+  CHECK( tts[0]._bits == 0x66 );
+  CHECK( tts[1]._bits == 0x11 );
+
+  aig = cleanup_dangling( aig );
+  CHECK( aig.num_gates() == 6u );
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig )[1]._bits == 0x11 );
+
+  /* slots for concurrent construction must fit into the child pointers */
+  const auto max_new_nodes = compact_aig_storage::node_type::pointer_type::max_index + 2u - aig.size();
+  CHECK_THROWS_AS( aig.enable_concurrent_strash( max_new_nodes ), std::length_error );
+  CHECK( !aig.has_concurrent_strash() );
+  aig.enable_concurrent_strash( 10u );
+  CHECK( aig.get_node( aig.create_and( x1, x2 ) ) < aig.size() );
+  aig.disable_concurrent_strash();
+}
+
+TEST_CASE( "compact an AIG in-place", "[aig]" )
+{
+  using node = aig_network::node;
+
+  aig_network aig;
+  const auto x1 = aig.create_pi();
+  const auto x2 = aig.create_pi();
+  const auto x3 = aig.create_pi();
+
+  const auto f1 = aig.create_and( x1, x2 );
+  const auto f2 = aig.create_and( f1, x3 );
+  const auto f3 = aig.create_and( x2, x3 );
+  const auto f4 = aig.create_and( !f2, f3 );
+  const auto f5 = aig.create_and( x1, !f4 );
+  aig.create_po( f5 );
+  aig.create_po( !f3 );
+
+  aig.enable_fanout_index();
+
+  /* makes f1 and f2 dead */
+  aig.substitute_node( aig.get_node( f2 ), x1 );
+  const auto tts = simulate<kitty::static_truth_table<3u>>( aig );
+  CHECK( aig.is_dead( aig.get_node( f1 ) ) );
+  CHECK( aig.is_dead( aig.get_node( f2 ) ) );
+  CHECK( aig.size() == 9u );
+  CHECK( aig.num_gates() == 3u );
+
+  const auto old_to_new = aig.compact();
+  CHECK( old_to_new == std::vector<node>{0u, 1u, 2u, 3u, std::numeric_limits<node>::max(), std::numeric_limits<node>::max(), 4u, 5u, 6u} );
+  CHECK( aig.size() == 7u );
+  CHECK( aig.num_gates() == 3u );
+  CHECK( aig._storage->hash.size() == 3u );
+  aig.foreach_node( [&]( auto const& n ) {
+    CHECK( !aig.is_dead( n ) );
+  } );
+  CHECK( aig.fanout_size( 4u ) == 2u );
+  CHECK( aig.po_at( 1u ) == !aig.make_signal( 4u ) );
+  CHECK( aig._storage->fanout_index.parents( 4u ) == std::vector<uint64_t>{5u} );
+
+  /* structural hashing works on the new indexes */
+  CHECK( aig.create_and( x2, x3 ) == aig.make_signal( 4u ) );
+  CHECK( aig.size() == 7u );
+
+  CHECK( simulate<kitty::static_truth_table<3u>>( aig ) == tts );
+
+  /* nothing to compact */
+  CHECK( aig.compact() == std::vector<node>{0u, 1u, 2u, 3u, 4u, 5u, 6u} );
+}
+
+TEST_CASE( "create AIG nodes from several threads", "[aig]" )
+{
+  aig_network aig;
+
+  std::vector<aig_network::signal> pis;
+  for ( auto i = 0u; i < 16u; ++i )
+  {
+    pis.push_back( aig.create_pi() );
+  }
+
+  aig.enable_concurrent_strash( 500u );
+
+  /* every thread creates all pairwise ANDs, starting from a different input */
+  std::vector<std::vector<aig_network::signal>> gates( 3u );
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < gates.size(); ++t )
+  {
+    threads.emplace_back( [&, t]() {
+      gates[t].resize( pis.size() * pis.size() );
+      for ( auto k = 0u; k < pis.size(); ++k )
+      {
+        const auto i = ( k + 5u * t ) % pis.size();
+        for ( auto j = 0u; j < pis.size(); ++j )
+        {
+          gates[t][i * pis.size() + j] = aig.create_and( pis[i], pis[j] );
+        }
+      }
+    } );
+  }
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  aig.disable_concurrent_strash();
+
+  CHECK( gates[0] == gates[1] );
+  CHECK( gates[0] == gates[2] );
+  CHECK( aig.num_gates() == 120u );
+  aig.foreach_pi( [&]( auto const& n ) {
+    CHECK( aig.fanout_size( n ) == 15u );
+  } );
+
+  /* running out of pre-allocated slots throws, and the nodes created so far are kept */
+  aig.enable_concurrent_strash( 2u );
+  aig.create_and( pis[0], !pis[1] );
+  aig.create_and( pis[0], !pis[2] );
+  CHECK_THROWS_AS( aig.create_and( pis[0], !pis[3] ), std::length_error );
+  CHECK_THROWS_AS( aig.create_and( pis[0], !pis[3] ), std::length_error );
+  CHECK( aig.create_and( pis[0], !pis[1] ) == aig.create_and( !pis[1], pis[0] ) );
+  aig.disable_concurrent_strash();
+  CHECK( aig.num_gates() == 122u );
+}
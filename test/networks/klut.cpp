@@ -573,3 +573,68 @@ TEST_CASE( "visited values in k-LUT networks", "[klut]" )
     CHECK( klut.visited( n ) == 0 );
   } );
 }
+
+TEST_CASE( "create and use an arena-based k-LUT network", "[klut]" )
+{
+  arena_klut_network klut;
+
+  CHECK( has_foreach_fanin_v<arena_klut_network> );
+  CHECK( has_substitute_node_v<arena_klut_network> );
+
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+
+  kitty::dynamic_truth_table tt_maj( 3u ), tt_xor( 3u );
+  kitty::create_from_hex_string( tt_maj, "e8" );
+  kitty::create_from_hex_string( tt_xor, "96" );
+
+  const auto n1 = klut.create_node( {a, b, c}, tt_maj );
+  const auto n2 = klut.create_node( {a, b, c}, tt_xor );
+  CHECK( klut.create_node( {a, b, c}, tt_maj ) == n1 );
+  const auto n3 = klut.create_and( n1, n2 );
+  const auto n4 = klut.create_xor( n1, c );
+  klut.create_po( n3 );
+
+  CHECK( klut.size() == 9 );
+  CHECK( klut.fanin_size( n1 ) == 3 );
+  CHECK( klut.fanin_size( n3 ) == 2 );
+  CHECK( klut.fanout_size( n1 ) == 2 );
+
+  std::vector<klut_network::node> fanins;
+  klut.foreach_fanin( n1, [&]( auto f ) { fanins.push_back( f ); } );
+  CHECK( fanins == std::vector<klut_network::node>{a, b, c} );
+
+  fanins.clear();
+  klut.foreach_fanin( n3, [&]( auto f ) { fanins.push_back( f ); } );
+  CHECK( fanins == std::vector<klut_network::node>{n1, n2} );
+
+  klut.substitute_node( n2, n4 );
+  fanins.clear();
+  klut.foreach_fanin( n3, [&]( auto f ) { fanins.push_back( f ); } );
+  CHECK( fanins == std::vector<klut_network::node>{n1, n4} );
+  CHECK( klut.fanout_size( n4 ) == 1 );
+
+  /* the structural hash table follows the substituted fan-ins */
+  CHECK( klut.create_and( n1, n4 ) == n3 );
+  CHECK( klut.create_and( n1, n2 ) != n3 );
+  CHECK( klut._storage->hash.size() == klut.size() - 5u );
+
+  fanins.clear();
+  klut.foreach_fanin( a, [&]( auto f ) { fanins.push_back( f ); } );
+  CHECK( fanins.empty() );
+
+  /* fan-ins of many nodes span several arena blocks */
+  auto f = klut.create_xor( a, b );
+  for ( auto i = 0u; i < 50000u; ++i )
+  {
+    f = klut.create_node( {f, a, b}, tt_xor );
+  }
+  klut.create_po( f );
+  fanins.clear();
+  klut.foreach_fanin( klut.get_node( f ), [&]( auto g ) { fanins.push_back( g ); } );
+  CHECK( fanins.size() == 3u );
+  CHECK( fanins[1] == a );
+  CHECK( fanins[2] == b );
+  CHECK( klut.size() == 50011 );
+}
@@ -4,6 +4,7 @@
 #include <kitty/dynamic_truth_table.hpp>
 #include <kitty/operations.hpp>
 #include <kitty/operators.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/traits.hpp>
 
@@ -687,3 +688,63 @@ TEST_CASE( "node substitution in MIGs", "[mig]" )
     }
   } );
 }
+
+TEST_CASE( "substitute nodes with fanout index in MIGs", "[mig]" )
+{
+  mig_network mig, ref;
+  CHECK( !mig.has_fanout_index() );
+  mig.enable_fanout_index();
+  CHECK( mig.has_fanout_index() );
+
+  for ( auto* ntk : {&mig, &ref} )
+  {
+    const auto x1 = ntk->create_pi();
+    const auto x2 = ntk->create_pi();
+    const auto x3 = ntk->create_pi();
+    const auto x4 = ntk->create_pi();
+
+    const auto f1 = ntk->create_maj( x1, x2, x4 );
+    const auto f2 = ntk->create_and( x3, x4 );
+    const auto f3 = ntk->create_maj( x1, x3, x4 );
+    const auto f4 = ntk->create_maj( f1, f2, x1 );
+    const auto f5 = ntk->create_and( f3, f4 );
+    const auto f6 = ntk->create_or( !f1, x2 );
+
+    ntk->create_po( f5 );
+    ntk->create_po( f6 );
+  }
+
+  const auto check_fanout_index = [&]() {
+    mig.foreach_node( [&]( auto const& n ) {
+      std::vector<uint64_t> fanouts;
+      mig.foreach_gate( [&]( auto const& g ) {
+        mig.foreach_fanin( g, [&]( auto const& f ) {
+          if ( mig.get_node( f ) == n )
+          {
+            fanouts.emplace_back( g );
+          }
+        } );
+      } );
+      CHECK( mig._storage->fanout_index.parents( n ) == fanouts );
+    } );
+  };
+
+  check_fanout_index();
+
+  mig.substitute_node( 2u, mig.make_signal( 3u ) );
+  ref.substitute_node( 2u, ref.make_signal( 3u ) );
+  check_fanout_index();
+  CHECK( mig.num_gates() == ref.num_gates() );
+  CHECK( simulate<kitty::static_truth_table<4u>>( mig ) == simulate<kitty::static_truth_table<4u>>( ref ) );
+
+  mig.substitute_node( 8u, !mig.make_signal( 4u ) );
+  ref.substitute_node( 8u, !ref.make_signal( 4u ) );
+  check_fanout_index();
+  CHECK( mig.num_gates() == ref.num_gates() );
+  CHECK( mig.is_dead( 8u ) );
+  CHECK( simulate<kitty::static_truth_table<4u>>( mig ) == simulate<kitty::static_truth_table<4u>>( ref ) );
+
+  mig.disable_fanout_index();
+  CHECK( !mig.has_fanout_index() );
+  CHECK( mig._storage->fanout_index.fanouts.num_bytes() == 0u );
+}
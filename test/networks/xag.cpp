@@ -1,6 +1,8 @@
 #include <catch.hpp>
 
 #include <algorithm>
+#include <stdexcept>
+#include <thread>
 #include <vector>
 
 #include <kitty/algorithm.hpp>
@@ -729,3 +731,169 @@ TEST_CASE( "create nary functions in XAGs", "[xag]" )
   kitty::create_parity( copy );
   CHECK( result[2] == copy );
 }
+
+TEST_CASE( "substitute nodes with fanout index in XAGs", "[xag]" )
+{
+  xag_network xag, ref;
+  CHECK( !xag.has_fanout_index() );
+  xag.enable_fanout_index();
+  CHECK( xag.has_fanout_index() );
+
+  for ( auto* ntk : {&xag, &ref} )
+  {
+    const auto x1 = ntk->create_pi();
+    const auto x2 = ntk->create_pi();
+    const auto x3 = ntk->create_pi();
+    const auto x4 = ntk->create_pi();
+
+    const auto f1 = ntk->create_xor( x1, x2 );
+    const auto f2 = ntk->create_and( x3, x4 );
+    const auto f3 = ntk->create_xor( x1, x3 );
+    const auto f4 = ntk->create_and( f1, f2 );
+    const auto f5 = ntk->create_xor( f3, f4 );
+    const auto f6 = ntk->create_and( !f1, x4 );
+
+    ntk->create_po( f5 );
+    ntk->create_po( f6 );
+  }
+
+  const auto check_fanout_index = [&]() {
+    xag.foreach_node( [&]( auto const& n ) {
+      std::vector<uint64_t> fanouts;
+      xag.foreach_gate( [&]( auto const& g ) {
+        xag.foreach_fanin( g, [&]( auto const& f ) {
+          if ( xag.get_node( f ) == n )
+          {
+            fanouts.emplace_back( g );
+          }
+        } );
+      } );
+      CHECK( xag._storage->fanout_index.parents( n ) == fanouts );
+    } );
+  };
+
+  check_fanout_index();
+
+  xag.substitute_node( 2u, xag.make_signal( 3u ) );
+  ref.substitute_node( 2u, ref.make_signal( 3u ) );
+  check_fanout_index();
+  CHECK( xag.num_gates() == ref.num_gates() );
+  CHECK( simulate<kitty::static_truth_table<4u>>( xag ) == simulate<kitty::static_truth_table<4u>>( ref ) );
+
+  xag.substitute_node( 8u, !xag.make_signal( 4u ) );
+  ref.substitute_node( 8u, !ref.make_signal( 4u ) );
+  check_fanout_index();
+  CHECK( xag.num_gates() == ref.num_gates() );
+  CHECK( xag.is_dead( 8u ) );
+  CHECK( simulate<kitty::static_truth_table<4u>>( xag ) == simulate<kitty::static_truth_table<4u>>( ref ) );
+
+  xag.disable_fanout_index();
+  CHECK( !xag.has_fanout_index() );
+  CHECK( xag._storage->fanout_index.fanouts.num_bytes() == 0u );
+}
+
+TEST_CASE( "create and use a compact XAG", "[xag]" )
+{
+  CHECK( sizeof( compact_xag_storage::node_type ) < sizeof( xag_storage::node_type ) );
+  CHECK( is_network_type_v<compact_xag_network> );
+  CHECK( has_create_xor_v<compact_xag_network> );
+
+  compact_xag_network xag;
+  const auto x1 = xag.create_pi();
+  const auto x2 = xag.create_pi();
+  const auto x3 = xag.create_pi();
+
+  const auto f1 = xag.create_xor( x1, x2 );
+  const auto f2 = xag.create_and( f1, !x3 );
+  xag.create_po( f2 );
+  xag.create_po( xag.create_xor3( x1, x2, x3 ) );
+
+  CHECK( xag.num_gates() == 3u );
+  CHECK( xag.is_xor( xag.get_node( f1 ) ) );
+  CHECK( xag.is_and( xag.get_node( f2 ) ) );
+
+  auto tts = simulate<kitty::static_truth_table<3u>>( xag );
+  CHECK( tts[0]._bits == 0x06 );
+  CHECK( tts[1]._bits == 0x96 );
+
+  xag.substitute_node( xag.get_node( x2 ), x1 );
+  tts = simulate<kitty::static_truth_table<3u>>( xag );
+  CHECK( tts[0]._bits == 0x00 );
+  CHECK( tts[1]._bits == 0xf0 );
+
+  /* slots for concurrent construction must fit into the child pointers */
+  const auto max_new_nodes = compact_xag_storage::node_type::pointer_type::max_index + 2u - xag.size();
+  CHECK_THROWS_AS( xag.enable_concurrent_strash( max_new_nodes ), std::length_error );
+  CHECK( !xag.has_concurrent_strash() );
+  xag.enable_concurrent_strash( 10u );
+  CHECK( xag.get_node( xag.create_xor( x1, x3 ) ) < xag.size() );
+  xag.disable_concurrent_strash();
+}
+
+TEST_CASE( "create XAG nodes from several threads", "[xag]" )
+{
+  xag_network xag, ref;
+
+  std::vector<xag_network::signal> pis, ref_pis;
+  for ( auto i = 0u; i < 8u; ++i )
+  {
+    pis.push_back( xag.create_pi() );
+    ref_pis.push_back( ref.create_pi() );
+  }
+  pis.push_back( xag.create_and( pis[0], pis[1] ) );
+  ref_pis.push_back( ref.create_and( ref_pis[0], ref_pis[1] ) );
+
+  /* all threads create the same gates, but in a different order */
+  const auto build = []( auto& ntk, auto const& inputs, uint32_t offset ) {
+    std::vector<xag_network::signal> gates( inputs.size() * inputs.size() * 2u );
+    for ( auto k = 0u; k < inputs.size(); ++k )
+    {
+      const auto i = ( k + offset ) % inputs.size();
+      for ( auto j = 0u; j < inputs.size(); ++j )
+      {
+        gates[2u * ( i * inputs.size() + j )] = ntk.create_and( inputs[i], !inputs[j] );
+        gates[2u * ( i * inputs.size() + j ) + 1u] = ntk.create_xor( inputs[i], inputs[j] );
+      }
+    }
+    return ntk.create_nary_xor( gates );
+  };
+
+  xag.enable_concurrent_strash( 1000u );
+  CHECK( xag.has_concurrent_strash() );
+
+  std::vector<xag_network::signal> results( 4u );
+  std::vector<std::thread> threads;
+  for ( auto t = 0u; t < results.size(); ++t )
+  {
+    threads.emplace_back( [&, t]() { results[t] = build( xag, pis, 3u * t ); } );
+  }
+  for ( auto& thread : threads )
+  {
+    thread.join();
+  }
+
+  xag.disable_concurrent_strash();
+  CHECK( !xag.has_concurrent_strash() );
+
+  const auto f = build( ref, ref_pis, 0u );
+  ref.create_po( f );
+
+  for ( auto const& r : results )
+  {
+    CHECK( r == results.front() );
+  }
+  xag.create_po( results.front() );
+
+  CHECK( xag.size() == ref.size() );
+  CHECK( xag.num_gates() == ref.num_gates() );
+  for ( auto const& pi : pis )
+  {
+    CHECK( xag.fanout_size( xag.get_node( pi ) ) == ref.fanout_size( ref.get_node( pi ) ) );
+  }
+  CHECK( simulate<kitty::static_truth_table<8u>>( xag )[0] == simulate<kitty::static_truth_table<8u>>( ref )[0] );
+
+  /* nodes are strashed against the merged hash table afterwards */
+  const auto size = xag.size();
+  xag.create_and( pis[2], !pis[3] );
+  CHECK( xag.size() == size );
+}
@@ -791,3 +791,63 @@ TEST_CASE( "create nary functions in XMGs", "[xmg]" )
   kitty::create_parity( copy );
   CHECK( result[2] == copy );
 }
+
+TEST_CASE( "substitute nodes with fanout index in XMGs", "[xmg]" )
+{
+  xmg_network xmg, ref;
+  CHECK( !xmg.has_fanout_index() );
+  xmg.enable_fanout_index();
+  CHECK( xmg.has_fanout_index() );
+
+  for ( auto* ntk : {&xmg, &ref} )
+  {
+    const auto x1 = ntk->create_pi();
+    const auto x2 = ntk->create_pi();
+    const auto x3 = ntk->create_pi();
+    const auto x4 = ntk->create_pi();
+
+    const auto f1 = ntk->create_xor3( x1, x2, x4 );
+    const auto f2 = ntk->create_and( x3, x4 );
+    const auto f3 = ntk->create_xor3( x1, x3, x4 );
+    const auto f4 = ntk->create_maj( f1, f2, x1 );
+    const auto f5 = ntk->create_xor( f3, f4 );
+    const auto f6 = ntk->create_or( !f1, x2 );
+
+    ntk->create_po( f5 );
+    ntk->create_po( f6 );
+  }
+
+  const auto check_fanout_index = [&]() {
+    xmg.foreach_node( [&]( auto const& n ) {
+      std::vector<uint64_t> fanouts;
+      xmg.foreach_gate( [&]( auto const& g ) {
+        xmg.foreach_fanin( g, [&]( auto const& f ) {
+          if ( xmg.get_node( f ) == n )
+          {
+            fanouts.emplace_back( g );
+          }
+        } );
+      } );
+      CHECK( xmg._storage->fanout_index.parents( n ) == fanouts );
+    } );
+  };
+
+  check_fanout_index();
+
+  xmg.substitute_node( 2u, xmg.make_signal( 3u ) );
+  ref.substitute_node( 2u, ref.make_signal( 3u ) );
+  check_fanout_index();
+  CHECK( xmg.num_gates() == ref.num_gates() );
+  CHECK( simulate<kitty::static_truth_table<4u>>( xmg ) == simulate<kitty::static_truth_table<4u>>( ref ) );
+
+  xmg.substitute_node( 8u, !xmg.make_signal( 4u ) );
+  ref.substitute_node( 8u, !ref.make_signal( 4u ) );
+  check_fanout_index();
+  CHECK( xmg.num_gates() == ref.num_gates() );
+  CHECK( xmg.is_dead( 8u ) );
+  CHECK( simulate<kitty::static_truth_table<4u>>( xmg ) == simulate<kitty::static_truth_table<4u>>( ref ) );
+
+  xmg.disable_fanout_index();
+  CHECK( !xmg.has_fanout_index() );
+  CHECK( xmg._storage->fanout_index.fanouts.num_bytes() == 0u );
+}
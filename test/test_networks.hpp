@@ -1,6 +1,13 @@
 #pragma once
 
+#include <catch.hpp>
+
+#include <algorithm>
 #include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <mockturtle/generators/arithmetic.hpp>
 
 namespace mockturtle
 {
@@ -25,4 +32,38 @@ public:
   uint64_t& _storage;
 };
 
+/* adds two `width`-bit operands as PIs and their carry-ripple product as POs, returns the operands */
+template<class Ntk>
+std::pair<std::vector<typename Ntk::signal>, std::vector<typename Ntk::signal>> create_multiplier( Ntk& ntk, uint32_t width )
+{
+  std::vector<typename Ntk::signal> a( width ), b( width );
+  std::generate( a.begin(), a.end(), [&]() { return ntk.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return ntk.create_pi(); } );
+  for ( auto const& f : carry_ripple_multiplier( ntk, a, b ) )
+  {
+    ntk.create_po( f );
+  }
+  return {a, b};
+}
+
+template<class Ntk>
+Ntk multiplier_network( uint32_t width )
+{
+  Ntk ntk;
+  create_multiplier( ntk, width );
+  return ntk;
+}
+
+/* compares two cut sets including the truth tables of their cuts */
+template<class Cuts1, class Cuts2>
+void check_same_cut_set( Cuts1 const& cuts1, typename Cuts1::cut_set_t const& set1, Cuts2 const& cuts2, typename Cuts2::cut_set_t const& set2 )
+{
+  REQUIRE( set1.size() == set2.size() );
+  for ( auto j = 0u; j < set1.size(); ++j )
+  {
+    CHECK( std::vector<uint32_t>( set1[j].begin(), set1[j].end() ) == std::vector<uint32_t>( set2[j].begin(), set2[j].end() ) );
+    CHECK( cuts1.truth_table( set1[j] ) == cuts2.truth_table( set2[j] ) );
+  }
+}
+
 }
@@ -0,0 +1,125 @@
+#include <catch.hpp>
+
+#include <mockturtle/utils/simd_kernels.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace mockturtle;
+
+TEST_CASE( "SIMD kernels agree with scalar kernels", "[simd_kernels]" )
+{
+  std::mt19937_64 rng( 42 );
+  const auto best = simd::detect_instruction_set();
+
+  for ( auto isa : {simd::instruction_set::scalar, simd::instruction_set::avx2, simd::instruction_set::avx512} )
+  {
+    if ( static_cast<int>( isa ) > static_cast<int>( best ) )
+    {
+      continue;
+    }
+
+    auto const& ref = simd::get_kernels( simd::instruction_set::scalar );
+    auto const& k = simd::get_kernels( isa );
+
+    /* lengths around the vector widths */
+    for ( auto num_words : {0u, 1u, 3u, 4u, 7u, 8u, 13u, 64u} )
+    {
+      std::vector<uint64_t> a( num_words ), b( num_words ), c( num_words ), expected( num_words ), actual( num_words );
+      std::generate( a.begin(), a.end(), rng );
+      std::generate( b.begin(), b.end(), rng );
+      std::generate( c.begin(), c.end(), rng );
+
+      for ( auto m = 0u; m < 8u; ++m )
+      {
+        const uint64_t ma = ( m & 1 ) ? ~UINT64_C( 0 ) : 0u;
+        const uint64_t mb = ( m & 2 ) ? ~UINT64_C( 0 ) : 0u;
+        const uint64_t mc = ( m & 4 ) ? ~UINT64_C( 0 ) : 0u;
+
+        ref.and2( expected.data(), a.data(), ma, b.data(), mb, num_words );
+        k.and2( actual.data(), a.data(), ma, b.data(), mb, num_words );
+        CHECK( actual == expected );
+
+        ref.xor2( expected.data(), a.data(), ma, b.data(), mb, num_words );
+        k.xor2( actual.data(), a.data(), ma, b.data(), mb, num_words );
+        CHECK( actual == expected );
+
+        ref.maj3( expected.data(), a.data(), ma, b.data(), mb, c.data(), mc, num_words );
+        k.maj3( actual.data(), a.data(), ma, b.data(), mb, c.data(), mc, num_words );
+        CHECK( actual == expected );
+
+        ref.xor3( expected.data(), a.data(), ma, b.data(), mb, c.data(), mc, num_words );
+        k.xor3( actual.data(), a.data(), ma, b.data(), mb, c.data(), mc, num_words );
+        CHECK( actual == expected );
+      }
+    }
+  }
+
+  /* scalar kernels against the definitions */
+  uint64_t out{};
+  const uint64_t x = 0xf0f0, y = 0xcccc, z = 0xaaaa;
+  simd::get_kernels( simd::instruction_set::scalar ).maj3( &out, &x, 0u, &y, 0u, &z, 0u, 1u );
+  CHECK( out == 0xe8e8 );
+  simd::get_kernels( simd::instruction_set::scalar ).xor3( &out, &x, 0u, &y, ~UINT64_C( 0 ), &z, 0u, 1u );
+  CHECK( out == ~UINT64_C( 0x9696 ) );
+}
+
+TEST_CASE( "SIMD cut kernels agree with scalar cut kernels", "[simd_kernels]" )
+{
+  std::mt19937 rng( 7 );
+  const auto best = simd::detect_instruction_set();
+  auto const& ref = simd::get_cut_kernels( simd::instruction_set::scalar );
+
+  /* sorted random leaf sets from a small range, so that they overlap */
+  const auto random_leaves = [&]( uint32_t size ) {
+    std::vector<uint32_t> leaves;
+    while ( leaves.size() < size )
+    {
+      leaves.push_back( rng() % 24u );
+      std::sort( leaves.begin(), leaves.end() );
+      leaves.erase( std::unique( leaves.begin(), leaves.end() ), leaves.end() );
+    }
+    return leaves;
+  };
+
+  for ( auto isa : {simd::instruction_set::scalar, simd::instruction_set::avx2, simd::instruction_set::avx512} )
+  {
+    if ( static_cast<int>( isa ) > static_cast<int>( best ) )
+    {
+      continue;
+    }
+
+    auto const& k = simd::get_cut_kernels( isa );
+    for ( auto i = 0u; i < 2000u; ++i )
+    {
+      const auto a = random_leaves( rng() % 11u );
+      const auto b = random_leaves( rng() % 11u );
+
+      for ( auto limit : {4u, 6u, 16u} )
+      {
+        std::vector<uint32_t> expected( 16u ), actual( 16u );
+        const auto ne = ref.leaves_union( a.data(), a.size(), b.data(), b.size(), expected.data(), limit );
+        const auto na = k.leaves_union( a.data(), a.size(), b.data(), b.size(), actual.data(), limit );
+        CHECK( ( ne > limit ) == ( na > limit ) );
+        if ( ne <= limit )
+        {
+          CHECK( na == ne );
+          CHECK( std::equal( expected.begin(), expected.begin() + ne, actual.begin() ) );
+        }
+      }
+
+      const auto& small = a.size() <= b.size() ? a : b;
+      const auto& large = a.size() <= b.size() ? b : a;
+      CHECK( k.leaves_subset( small.data(), small.size(), large.data(), large.size() ) == ref.leaves_subset( small.data(), small.size(), large.data(), large.size() ) );
+      CHECK( k.leaves_subset( small.data(), small.size(), large.data(), large.size() ) == std::includes( large.begin(), large.end(), small.begin(), small.end() ) );
+    }
+  }
+
+  /* scalar union against the definition */
+  const std::vector<uint32_t> x{0u, 2u, 5u}, y{1u, 2u, 7u};
+  std::vector<uint32_t> out( 5u );
+  CHECK( ref.leaves_union( x.data(), 3u, y.data(), 3u, out.data(), 5u ) == 5u );
+  CHECK( out == std::vector<uint32_t>{0u, 1u, 2u, 5u, 7u} );
+  CHECK( ref.leaves_union( x.data(), 3u, y.data(), 3u, out.data(), 4u ) > 4u );
+}
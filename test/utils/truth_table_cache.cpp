@@ -3,6 +3,7 @@
 #include <mockturtle/utils/truth_table_cache.hpp>
 #include <kitty/constructors.hpp>
 #include <kitty/dynamic_truth_table.hpp>
+#include <kitty/static_truth_table.hpp>
 
 using namespace mockturtle;
 
@@ -45,3 +46,28 @@ TEST_CASE( "working with a truth table cache", "[truth_table_cache]" )
   CHECK( cache[8] == f_maj );
   CHECK( cache[9] == ~f_maj );
 }
+
+TEST_CASE( "truth table cache for small static truth tables", "[truth_table_cache]" )
+{
+  truth_table_cache<kitty::static_truth_table<3>> cache( 4u );
+  truth_table_cache<kitty::dynamic_truth_table> reference;
+
+  /* all functions over 3 variables, several times, to grow the hash table */
+  for ( auto round = 0u; round < 2u; ++round )
+  {
+    for ( auto word = 0u; word < 256u; ++word )
+    {
+      kitty::static_truth_table<3> tt;
+      kitty::dynamic_truth_table dtt( 3u );
+      kitty::create_from_words( tt, &word, &word + 1 );
+      kitty::create_from_words( dtt, &word, &word + 1 );
+
+      const auto lit = cache.insert( tt );
+      CHECK( lit == reference.insert( dtt ) );
+      CHECK( cache[lit] == tt );
+      CHECK( cache[lit ^ 1] == ~tt );
+    }
+  }
+
+  CHECK( cache.size() == 128u );
+}
@@ -1,6 +1,8 @@
 #include <catch.hpp>
 
 #include <mockturtle/traits.hpp>
+#include <mockturtle/algorithms/mig_algebraic_rewriting.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
 #include <mockturtle/networks/aig.hpp>
 #include <mockturtle/networks/mig.hpp>
 #include <mockturtle/networks/klut.hpp>
@@ -238,3 +240,89 @@ TEST_CASE( "compute levels during node construction after move assignment", "[de
 
   CHECK( dxag.depth() == 3u );
 }
+
+TEST_CASE( "update levels incrementally after substitution", "[depth_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto d = aig.create_pi();
+
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_and( f2, d );
+  const auto f4 = aig.create_and( f3, a );
+  const auto f5 = aig.create_and( b, c );
+  aig.create_po( f4 );
+  aig.create_po( f5 );
+
+  depth_view_params ps;
+  ps.incremental = true;
+  depth_view daig{aig, {}, ps};
+
+  CHECK( daig.depth() == 4u );
+  CHECK( daig.is_on_critical_path( aig.get_node( f1 ) ) );
+  CHECK( !daig.is_on_critical_path( aig.get_node( f5 ) ) );
+
+  /* balance the chain: levels decrease in the transitive fanout */
+  const auto g = daig.create_and( daig.create_and( a, b ), daig.create_and( c, d ) );
+  CHECK( daig.level( aig.get_node( g ) ) == 2u );
+  daig.substitute_node( aig.get_node( f3 ), g );
+
+  CHECK( daig.level( aig.get_node( f4 ) ) == 3u );
+  CHECK( daig.depth() == 3u );
+  CHECK( daig.is_on_critical_path( aig.get_node( g ) ) );
+  CHECK( !daig.is_on_critical_path( aig.get_node( f2 ) ) );
+
+  /* levels increase again */
+  const auto h = daig.create_and( daig.create_and( f5, d ), daig.create_and( !f5, a ) );
+  daig.substitute_node( aig.get_node( g ), daig.create_and( h, b ) );
+
+  CHECK( daig.level( aig.get_node( f4 ) ) == 5u );
+  CHECK( daig.depth() == 5u );
+  CHECK( daig.is_on_critical_path( aig.get_node( f5 ) ) );
+
+  /* update_levels keeps the incrementally computed levels */
+  daig.update_levels();
+  CHECK( daig.level( aig.get_node( f4 ) ) == 5u );
+  CHECK( daig.depth() == 5u );
+
+  daig.set_level( aig.get_node( f4 ), 0u );
+  daig.update_levels();
+  CHECK( daig.level( aig.get_node( f4 ) ) == 5u );
+}
+
+TEST_CASE( "update levels incrementally during depth rewriting", "[depth_view]" )
+{
+  mig_network mig;
+  std::vector<mig_network::signal> a( 8u ), b( 8u );
+  std::generate( a.begin(), a.end(), [&]() { return mig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return mig.create_pi(); } );
+  auto carry = mig.get_constant( false );
+  carry_ripple_adder_inplace( mig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { mig.create_po( f ); } );
+  mig.create_po( carry );
+
+  depth_view_params ps;
+  ps.incremental = true;
+  depth_view dmig{mig, {}, ps};
+  const auto depth_before = dmig.depth();
+
+  mig_algebraic_depth_rewriting_params rps;
+  rps.allow_area_increase = true;
+  mig_algebraic_depth_rewriting( dmig, rps );
+
+  CHECK( dmig.depth() < depth_before );
+
+  /* compare with levels computed from scratch on the reachable nodes */
+  depth_view fresh{mig};
+  CHECK( dmig.depth() == fresh.depth() );
+  mig.foreach_node( [&]( auto const& n ) {
+    if ( mig.visited( n ) == mig.trav_id() )
+    {
+      CHECK( dmig.level( n ) == fresh.level( n ) );
+      CHECK( dmig.is_on_critical_path( n ) == fresh.is_on_critical_path( n ) );
+    }
+  } );
+}
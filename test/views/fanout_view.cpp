@@ -199,3 +199,39 @@ TEST_CASE( "compute fanouts during node construction after move assignment", "[f
     CHECK( fanouts.size() + ( xag.get_node( f ) == n ) == xag.fanout_size( n ) );
   } );
 }
+
+TEST_CASE( "update fanouts of high-fanout nodes incrementally", "[fanout_view]" )
+{
+  aig_network aig;
+  fanout_view<aig_network> faig{aig};
+
+  const auto en = faig.create_pi();
+  std::vector<aig_network::signal> pis, gates;
+  for ( auto i = 0u; i < 64u; ++i )
+  {
+    pis.push_back( faig.create_pi() );
+    gates.push_back( faig.create_and( en, pis.back() ) );
+  }
+  for ( auto i = 0u; i + 1u < gates.size(); i += 2u )
+  {
+    faig.create_po( faig.create_or( gates[i], gates[i + 1u] ) );
+  }
+  CHECK( faig.fanout( faig.get_node( en ) ).size() == 64u );
+  CHECK( faig.fanout_memory_footprint() > 0u );
+
+  /* replace every third gate, which modifies and deletes fanouts of `en` */
+  for ( auto i = 0u; i < gates.size(); i += 3u )
+  {
+    faig.substitute_node( faig.get_node( gates[i] ), faig.create_and( !en, pis[i] ) );
+  }
+
+  fanout_view<aig_network> ref{aig};
+  aig.foreach_node( [&]( auto const& n ) {
+    std::set<node<aig_network>> fanouts, ref_fanouts;
+    faig.foreach_fanout( n, [&]( auto const& p ) { fanouts.insert( p ); } );
+    ref.foreach_fanout( n, [&]( auto const& p ) { ref_fanouts.insert( p ); } );
+    CHECK( fanouts == ref_fanouts );
+    CHECK( faig.fanout( n ).size() == fanouts.size() );
+  } );
+  CHECK( faig.fanout( faig.get_node( en ) ).size() == 64u );
+}
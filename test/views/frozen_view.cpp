@@ -0,0 +1,141 @@
+#include <catch.hpp>
+
+#include <vector>
+
+#include <kitty/static_truth_table.hpp>
+#include <mockturtle/algorithms/cut_enumeration.hpp>
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/views/depth_view.hpp>
+#include <mockturtle/views/fanout_view.hpp>
+#include <mockturtle/views/frozen_view.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "create a frozen_view on an AIG", "[frozen_view]" )
+{
+  aig_network aig;
+
+  CHECK( !has_level_v<aig_network> );
+  CHECK( !has_foreach_fanout_v<aig_network> );
+  CHECK( has_level_v<frozen_view<aig_network>> );
+  CHECK( has_depth_v<frozen_view<aig_network>> );
+  CHECK( has_foreach_fanout_v<frozen_view<aig_network>> );
+  CHECK( is_topologically_sorted_v<frozen_view<aig_network>> );
+
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, !c );
+  const auto f3 = aig.create_or( f2, a );
+  const auto dangling = aig.create_and( b, c );
+  aig.create_po( f3 );
+  aig.create_po( !f1 );
+
+  frozen_view frozen{aig};
+  depth_view depth{aig};
+  fanout_view fanout{aig};
+
+  CHECK( frozen.depth() == depth.depth() );
+  aig.foreach_node( [&]( auto const& n ) {
+    /* depth_view only computes levels in the transitive fanin of the POs */
+    CHECK( frozen.level( n ) == ( n == aig.get_node( dangling ) ? 1u : depth.level( n ) ) );
+    CHECK( frozen.fanin_size( n ) == aig.fanin_size( n ) );
+
+    std::vector<aig_network::signal> fanins, expected_fanins;
+    frozen.foreach_fanin( n, [&]( auto const& f ) { fanins.push_back( f ); } );
+    aig.foreach_fanin( n, [&]( auto const& f ) { expected_fanins.push_back( f ); } );
+    CHECK( fanins == expected_fanins );
+
+    std::vector<aig_network::node> fanouts, expected_fanouts;
+    frozen.foreach_fanout( n, [&]( auto const& p ) { fanouts.push_back( p ); } );
+    fanout.foreach_fanout( n, [&]( auto const& p ) { expected_fanouts.push_back( p ); } );
+    std::sort( expected_fanouts.begin(), expected_fanouts.end() );
+    CHECK( fanouts == expected_fanouts );
+  } );
+
+  /* all nodes are visited in topological order */
+  std::vector<bool> seen( aig.size() );
+  uint32_t num_nodes{0}, num_gates{0};
+  frozen.foreach_node( [&]( auto const& n ) {
+    frozen.foreach_fanin( n, [&]( auto const& f ) {
+      CHECK( seen[aig.get_node( f )] );
+    } );
+    seen[n] = true;
+    ++num_nodes;
+  } );
+  frozen.foreach_gate( [&]( auto const& ) { ++num_gates; } );
+  CHECK( num_nodes == aig.size() );
+  CHECK( num_gates == aig.num_gates() );
+
+  CHECK( simulate<kitty::static_truth_table<3u>>( frozen ) == simulate<kitty::static_truth_table<3u>>( aig ) );
+}
+
+TEST_CASE( "frozen_view on an AIG that is not in topological order", "[frozen_view]" )
+{
+  aig_network aig;
+
+  const auto x1 = aig.create_pi();
+  const auto x2 = aig.create_pi();
+  const auto x3 = aig.create_pi();
+  const auto g1 = aig.create_and( x1, x2 );
+  const auto g2 = aig.create_and( x2, x3 );
+  const auto g3 = aig.create_and( g1, x3 );
+  const auto g4 = aig.create_and( g3, g2 );
+  aig.create_po( g4 );
+
+  /* g1 now depends on g2, which has a larger index */
+  aig.substitute_node( aig.get_node( x1 ), g2 );
+
+  frozen_view frozen{aig};
+
+  std::vector<aig_network::node> order;
+  frozen.foreach_gate( [&]( auto const& n ) { order.push_back( n ); } );
+  CHECK( order.size() == 4u );
+
+  const auto pos = [&]( auto const& f ) {
+    return std::find( order.begin(), order.end(), aig.get_node( f ) ) - order.begin();
+  };
+  CHECK( pos( g2 ) < pos( g1 ) );
+  CHECK( pos( g1 ) < pos( g3 ) );
+  CHECK( pos( g3 ) < pos( g4 ) );
+  CHECK( frozen.depth() == 4u );
+
+  /* the arrays are ordered by topological position, not by node index */
+  CHECK( frozen.level( aig.get_node( g2 ) ) == 1u );
+  CHECK( frozen.level( aig.get_node( g1 ) ) == 2u );
+  CHECK( frozen.level( aig.get_node( g4 ) ) == 4u );
+  aig.foreach_node( [&]( auto const& n ) {
+    std::vector<aig_network::signal> fanins, expected_fanins;
+    frozen.foreach_fanin( n, [&]( auto const& f ) { fanins.push_back( f ); } );
+    aig.foreach_fanin( n, [&]( auto const& f ) { expected_fanins.push_back( f ); } );
+    CHECK( fanins == expected_fanins );
+  } );
+
+  std::vector<aig_network::node> fanouts;
+  frozen.foreach_fanout( aig.get_node( g2 ), [&]( auto const& p ) { fanouts.push_back( p ); } );
+  CHECK( fanouts == std::vector<aig_network::node>{aig.get_node( g1 ), aig.get_node( g4 )} );
+}
+
+TEST_CASE( "enumerate cuts on a frozen_view of a k-LUT network", "[frozen_view]" )
+{
+  klut_network klut;
+
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+  const auto f1 = klut.create_xor( a, b );
+  const auto f2 = klut.create_maj( f1, b, c );
+  klut.create_po( f2 );
+
+  frozen_view frozen{klut};
+  CHECK( frozen.depth() == 2u );
+  CHECK( frozen.level( f1 ) == 1u );
+
+  const auto cuts = cut_enumeration( frozen );
+  const auto ref_cuts = cut_enumeration( klut );
+  CHECK( cuts.cuts( frozen.node_to_index( f2 ) ).size() == ref_cuts.cuts( klut.node_to_index( f2 ) ).size() );
+}
@@ -0,0 +1,135 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/simulation.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/klut.hpp>
+#include <mockturtle/networks/xag.hpp>
+#include <mockturtle/views/simulation_view.hpp>
+#include <mockturtle/views/topo_view.hpp>
+
+#include <kitty/partial_truth_table.hpp>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace mockturtle;
+
+template<class Ntk, class Simulator>
+static void check_simulation_values( simulation_view<Ntk, Simulator> const& sntk, Simulator const& sim )
+{
+  /* substitutions may create nodes out of index order */
+  topo_view topo{static_cast<Ntk const&>( sntk )};
+  const auto tts = simulate_nodes<kitty::partial_truth_table>( topo, sim );
+  sntk.foreach_po( [&]( auto const& f ) {
+    CHECK( sntk.simulation_value( sntk.get_node( f ) ) == tts[f] );
+  } );
+  topo.foreach_gate( [&]( auto const& n ) {
+    CHECK( sntk.simulation_value( n ) == tts[n] );
+  } );
+}
+
+template<class Ntk>
+static void add_random_patterns( partial_simulator& sim, Ntk const& ntk, uint32_t num_patterns, std::default_random_engine& rng )
+{
+  std::vector<bool> pattern( ntk.num_pis() );
+  for ( auto i = 0u; i < num_patterns; ++i )
+  {
+    for ( auto j = 0u; j < pattern.size(); ++j )
+    {
+      pattern[j] = rng() & 1u;
+    }
+    sim.add_pattern( pattern );
+  }
+}
+
+TEST_CASE( "simulation view appends new patterns", "[simulation_view]" )
+{
+  xag_network xag;
+  std::vector<xag_network::signal> a( 8u ), b( 8u );
+  std::generate( a.begin(), a.end(), [&]() { return xag.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return xag.create_pi(); } );
+  auto carry = xag.get_constant( false );
+  carry_ripple_adder_inplace( xag, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { xag.create_po( f ); } );
+  xag.create_po( carry );
+
+  std::default_random_engine rng( 42u );
+  partial_simulator sim( xag.num_pis(), 100u, rng() );
+  simulation_view sxag{xag, sim};
+  check_simulation_values( sxag, sim );
+
+  /* patterns crossing a word boundary and several new words */
+  add_random_patterns( sim, xag, 1u, rng );
+  check_simulation_values( sxag, sim );
+  add_random_patterns( sim, xag, 150u, rng );
+  check_simulation_values( sxag, sim );
+}
+
+TEST_CASE( "simulation view updates the fanout of substituted nodes", "[simulation_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_and( !f2, a );
+  aig.create_po( f3 );
+  aig.create_po( f2 );
+
+  std::default_random_engine rng( 1u );
+  partial_simulator sim( aig.num_pis(), 64u, rng() );
+  simulation_view saig{aig, sim};
+  check_simulation_values( saig, sim );
+
+  CHECK( saig.is_up_to_date( aig.get_node( f3 ) ) );
+  const auto g = saig.create_or( b, c );
+  saig.substitute_node( aig.get_node( f1 ), g );
+  CHECK( !saig.is_up_to_date( aig.get_node( g ) ) );
+  CHECK( saig.is_up_to_date( aig.get_node( a ) ) );
+  check_simulation_values( saig, sim );
+
+  add_random_patterns( sim, aig, 10u, rng );
+  saig.substitute_node( saig.get_node( f2 ), saig.create_xor( a, c ) );
+  check_simulation_values( saig, sim );
+}
+
+TEST_CASE( "simulation view on k-LUT network", "[simulation_view]" )
+{
+  klut_network klut;
+  const auto a = klut.create_pi();
+  const auto b = klut.create_pi();
+  const auto c = klut.create_pi();
+  const auto f1 = klut.create_maj( a, b, c );
+  const auto f2 = klut.create_xor( f1, c );
+  klut.create_po( f2 );
+
+  std::default_random_engine rng( 7u );
+  partial_simulator sim( klut.num_pis(), 70u, rng() );
+  simulation_view sklut{klut, sim};
+  check_simulation_values( sklut, sim );
+
+  add_random_patterns( sim, klut, 3u, rng );
+  sklut.substitute_node( klut.get_node( f1 ), sklut.create_and( a, b ) );
+  check_simulation_values( sklut, sim );
+}
+
+TEST_CASE( "simulation view rejects register outputs", "[simulation_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto r = aig.create_ro();
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, r );
+  aig.create_po( f1 );
+  aig.create_ri( f2 );
+
+  partial_simulator sim( aig.num_pis(), 64u );
+  simulation_view saig{aig, sim};
+  CHECK( saig.simulation_value( aig.get_node( f1 ) ) == ( sim.compute_pi( 0u ) & sim.compute_pi( 1u ) ) );
+  CHECK_THROWS_AS( saig.simulation_value( aig.get_node( f2 ) ), std::invalid_argument );
+}
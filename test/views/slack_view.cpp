@@ -0,0 +1,92 @@
+#include <catch.hpp>
+
+#include <mockturtle/algorithms/mig_algebraic_rewriting.hpp>
+#include <mockturtle/generators/arithmetic.hpp>
+#include <mockturtle/networks/aig.hpp>
+#include <mockturtle/networks/mig.hpp>
+#include <mockturtle/traits.hpp>
+#include <mockturtle/views/slack_view.hpp>
+
+using namespace mockturtle;
+
+TEST_CASE( "compute arrival, required times, and slack", "[slack_view]" )
+{
+  aig_network aig;
+  const auto a = aig.create_pi();
+  const auto b = aig.create_pi();
+  const auto c = aig.create_pi();
+  const auto d = aig.create_pi();
+
+  const auto f1 = aig.create_and( a, b );
+  const auto f2 = aig.create_and( f1, c );
+  const auto f3 = aig.create_and( f2, d );
+  const auto f4 = aig.create_and( c, d );
+  aig.create_po( f3 );
+  aig.create_po( f4 );
+
+  slack_view saig{aig};
+
+  CHECK( has_depth_v<decltype( saig )> );
+  CHECK( saig.required_time() == 3u );
+  CHECK( saig.arrival( aig.get_node( f3 ) ) == 3u );
+  CHECK( saig.required( aig.get_node( f3 ) ) == 3 );
+  CHECK( saig.slack( aig.get_node( f1 ) ) == 0 );
+  CHECK( saig.slack( aig.get_node( f4 ) ) == 2 );
+  CHECK( saig.required( aig.get_node( d ) ) == 2 );
+  CHECK( saig.required( aig.get_node( c ) ) == 1 );
+  CHECK( saig.slack( aig.get_node( d ) ) == 2 );
+
+  saig.set_required_time( 2u );
+  CHECK( saig.slack( aig.get_node( f1 ) ) == -1 );
+  CHECK( saig.slack( aig.get_node( f4 ) ) == 1 );
+  saig.set_required_time( 0u );
+
+  /* f4 is fast enough to replace f1, but f2 is not */
+  CHECK( saig.is_timing_legal( aig.get_node( f1 ), f4 ) );
+  CHECK( !saig.is_timing_legal( aig.get_node( f1 ), f2 ) );
+
+  /* required times of the remaining nodes follow the substitution */
+  saig.substitute_node( aig.get_node( f2 ), f4 );
+  CHECK( saig.required_time() == 2u );
+  CHECK( saig.slack( aig.get_node( f4 ) ) == 0 );
+  CHECK( saig.required( aig.get_node( d ) ) == 0 );
+  CHECK( saig.required( aig.get_node( a ) ) == 2 );
+
+  /* new PO on a deeper node */
+  const auto g = saig.create_and( saig.create_and( f3, b ), a );
+  saig.create_po( g );
+  CHECK( saig.required_time() == 4u );
+  CHECK( saig.slack( aig.get_node( g ) ) == 0 );
+  CHECK( saig.slack( aig.get_node( f4 ) ) == 0 );
+  CHECK( saig.required( aig.get_node( b ) ) == 2 );
+}
+
+TEST_CASE( "update slack incrementally during depth rewriting", "[slack_view]" )
+{
+  mig_network mig;
+  std::vector<mig_network::signal> a( 8u ), b( 8u );
+  std::generate( a.begin(), a.end(), [&]() { return mig.create_pi(); } );
+  std::generate( b.begin(), b.end(), [&]() { return mig.create_pi(); } );
+  auto carry = mig.get_constant( false );
+  carry_ripple_adder_inplace( mig, a, b, carry );
+  std::for_each( a.begin(), a.end(), [&]( auto const& f ) { mig.create_po( f ); } );
+  mig.create_po( carry );
+
+  slack_view smig{mig};
+  smig.foreach_node( [&]( auto const& n ) {
+    CHECK( smig.slack( n ) >= 0 );
+  } );
+
+  mig_algebraic_depth_rewriting( smig );
+
+  /* compare with the required times of a fresh view */
+  slack_view fresh{mig};
+  CHECK( smig.required_time() == fresh.required_time() );
+  smig.foreach_gate( [&]( auto const& n ) {
+    if ( mig.fanout_size( n ) > 0u )
+    {
+      CHECK( smig.arrival( n ) == fresh.arrival( n ) );
+      CHECK( smig.required( n ) == fresh.required( n ) );
+    }
+  } );
+}